@@ -12,7 +12,6 @@
 #include <set>
 #include <iostream>
 #include <cstring>
-#include <mutex>
 #include <chrono>
 #include <cmath>
 #include <algorithm>
@@ -34,6 +33,7 @@ extern "C" {
 #include "samplecrate_rsx.h"
 #include "regroove_effects.h"
 #include "midi.h"
+#include "midi_clock_pll.h"
 #include "midi_output.h"
 #include "input_mappings.h"
 #include "sfz_builder.h"
@@ -88,7 +88,6 @@ SamplecrateEngine* engine = nullptr;
 // GUI-ONLY STATE - Does not affect headless operation
 // =============================================================================
 std::atomic<bool> running(true);
-std::mutex synth_mutex;
 LCD* lcd_display = nullptr;
 int current_note = -1;
 int current_velocity = 0;
@@ -118,6 +117,12 @@ std::string rsx_file_path = "";
 SamplecrateFileList* file_list = nullptr;
 bool file_browser_mode = false;  // Set to true when browsing (shows filename in LCD)
 
+// Background kit load (file browser): progress comes from the loading threads
+std::atomic<int> kit_load_loaded(0);
+std::atomic<int> kit_load_total(0);
+bool kit_loading = false;
+std::string kit_load_path;
+
 // Pattern sequencer (single source of truth for pattern position)
 MednessSequencer* sequencer = nullptr;
 
@@ -154,21 +159,35 @@ int midi_target_program[3] = {0, 0, 0};  // Per-device MIDI routing (set by prog
 struct {
     bool active = false;           // Receiving MIDI clock
     bool running = false;          // Transport running (start/continue)
-    float bpm = 0.0f;             // Calculated BPM
-    float smoothed_bpm = 0.0f;    // Smoothed BPM for exponential moving average filter
+    float bpm = 0.0f;             // Recovered BPM (from the clock PLL)
     uint64_t last_clock_time = 0; // Last clock pulse timestamp (microseconds)
     int pulse_count = 0;          // Pulses since last beat (0-23)
     int beat_count = 0;           // Total quarter note beats since start
     int total_pulse_count = 0;    // Total pulses since start (for sub-beat precision: 24 ppqn)
-    uint64_t last_bpm_calc_time = 0; // Last BPM calculation time
     int spp_position = 0;         // Song Position Pointer (in 16th notes / MIDI beats)
     bool spp_synced = false;      // True if we've received SPP and synced to it
 
-    // Consecutive rejection tracking (for accepting large tempo changes)
-    float last_rejected_bpm = 0.0f;  // Last rejected BPM value
-    int consecutive_rejections = 0;   // How many times we rejected similar BPM
+    // Clock recovery: tempo and phase of the master from pulse timestamps
+    MidiClockPll pll;
+    bool position_known = false;  // Master song position known (Start or SPP received)
+    int64_t next_song_pulse = 0;  // Master song position of the next pulse (24 ppqn)
+    float phase_error = 0.0f;     // Sequencer phase vs master at the last pulse (pulses, + = behind)
+    int pll_reset_requested = 0;  // Set by the audio thread on a clock timeout; the MIDI thread resets the PLL
 } midi_clock;
 
+// Clock PLL loop bandwidth (Hz) and sequencer phase correction per pulse
+#define MIDI_CLOCK_PLL_BANDWIDTH 1.0
+#define MIDI_CLOCK_PHASE_GAIN 0.1f      // Fraction of the phase error corrected per pulse
+#define MIDI_CLOCK_PHASE_MAX_STEP 0.25f // Largest correction per pulse (pulses)
+
+// MIDI clock output (master mode): generated in the audio callback from the
+// sequencer's song position, sent by the MIDI output thread
+struct {
+    bool running = false;          // SPP + Start/Continue sent, clock pulses flowing
+    int64_t next_pulse = 0;        // Song position (24 ppqn) of the next clock pulse to send
+    double last_song_pulse = 0.0;  // Song position at the end of the previous block
+} midi_clock_out;
+
 // Error message for LCD display
 std::string error_message = "";
 
@@ -215,7 +234,7 @@ bool expanded_pads = false;
 // Track currently held pad for note_off on release
 int held_pad_index = -1;
 int held_pad_note = -1;
-sfizz_synth_t* held_pad_synth = nullptr;
+int held_pad_program = -1;
 
 // UI mode
 enum UIMode {
@@ -245,57 +264,37 @@ RegrooveEffects* get_current_effects() {
     } else {
         // FX_MODE_PROGRAM - return current program's effects
         if (current_program >= 0 && current_program < RSX_MAX_PROGRAMS) {
-            return engine->effects_program[current_program];
+            return samplecrate_engine_ensure_program_effects(engine, current_program);
         }
         return nullptr;
     }
 }
 
-// Helper: apply RSX effects settings to RegrooveEffects instance
-void apply_rsx_effects_to_instance(RegrooveEffects* fx, const RSXEffectsSettings* rsx_fx) {
-    if (!fx || !rsx_fx) return;
-
-    // Distortion
-    regroove_effects_set_distortion_enabled(fx, rsx_fx->distortion_enabled);
-    regroove_effects_set_distortion_drive(fx, rsx_fx->distortion_drive);
-    regroove_effects_set_distortion_mix(fx, rsx_fx->distortion_mix);
-
-    // Filter
-    regroove_effects_set_filter_enabled(fx, rsx_fx->filter_enabled);
-    regroove_effects_set_filter_cutoff(fx, rsx_fx->filter_cutoff);
-    regroove_effects_set_filter_resonance(fx, rsx_fx->filter_resonance);
-
-    // EQ
-    regroove_effects_set_eq_enabled(fx, rsx_fx->eq_enabled);
-    regroove_effects_set_eq_low(fx, rsx_fx->eq_low);
-    regroove_effects_set_eq_mid(fx, rsx_fx->eq_mid);
-    regroove_effects_set_eq_high(fx, rsx_fx->eq_high);
-
-    // Compressor
-    regroove_effects_set_compressor_enabled(fx, rsx_fx->compressor_enabled);
-    regroove_effects_set_compressor_threshold(fx, rsx_fx->compressor_threshold);
-    regroove_effects_set_compressor_ratio(fx, rsx_fx->compressor_ratio);
-    regroove_effects_set_compressor_attack(fx, rsx_fx->compressor_attack);
-    regroove_effects_set_compressor_release(fx, rsx_fx->compressor_release);
-    regroove_effects_set_compressor_makeup(fx, rsx_fx->compressor_makeup);
-
-    // Phaser
-    regroove_effects_set_phaser_enabled(fx, rsx_fx->phaser_enabled);
-    regroove_effects_set_phaser_rate(fx, rsx_fx->phaser_rate);
-    regroove_effects_set_phaser_depth(fx, rsx_fx->phaser_depth);
-    regroove_effects_set_phaser_feedback(fx, rsx_fx->phaser_feedback);
-
-    // Reverb
-    regroove_effects_set_reverb_enabled(fx, rsx_fx->reverb_enabled);
-    regroove_effects_set_reverb_room_size(fx, rsx_fx->reverb_room_size);
-    regroove_effects_set_reverb_damping(fx, rsx_fx->reverb_damping);
-    regroove_effects_set_reverb_mix(fx, rsx_fx->reverb_mix);
-
-    // Delay
-    regroove_effects_set_delay_enabled(fx, rsx_fx->delay_enabled);
-    regroove_effects_set_delay_time(fx, rsx_fx->delay_time);
-    regroove_effects_set_delay_feedback(fx, rsx_fx->delay_feedback);
-    regroove_effects_set_delay_mix(fx, rsx_fx->delay_mix);
+// Helper: apply config file effect defaults to a RegrooveEffects instance
+void apply_config_effects_defaults(RegrooveEffects* fx) {
+    if (!fx) return;
+
+    regroove_effects_set_distortion_drive(fx, config.fx_distortion_drive);
+    regroove_effects_set_distortion_mix(fx, config.fx_distortion_mix);
+    regroove_effects_set_filter_cutoff(fx, config.fx_filter_cutoff);
+    regroove_effects_set_filter_resonance(fx, config.fx_filter_resonance);
+    regroove_effects_set_eq_low(fx, config.fx_eq_low);
+    regroove_effects_set_eq_mid(fx, config.fx_eq_mid);
+    regroove_effects_set_eq_high(fx, config.fx_eq_high);
+    regroove_effects_set_compressor_threshold(fx, config.fx_compressor_threshold);
+    regroove_effects_set_compressor_ratio(fx, config.fx_compressor_ratio);
+    regroove_effects_set_compressor_attack(fx, config.fx_compressor_attack);
+    regroove_effects_set_compressor_release(fx, config.fx_compressor_release);
+    regroove_effects_set_compressor_makeup(fx, config.fx_compressor_makeup);
+    regroove_effects_set_phaser_rate(fx, config.fx_phaser_rate);
+    regroove_effects_set_phaser_depth(fx, config.fx_phaser_depth);
+    regroove_effects_set_phaser_feedback(fx, config.fx_phaser_feedback);
+    regroove_effects_set_reverb_room_size(fx, config.fx_reverb_room_size);
+    regroove_effects_set_reverb_damping(fx, config.fx_reverb_damping);
+    regroove_effects_set_reverb_mix(fx, config.fx_reverb_mix);
+    regroove_effects_set_delay_time(fx, config.fx_delay_time);
+    regroove_effects_set_delay_feedback(fx, config.fx_delay_feedback);
+    regroove_effects_set_delay_mix(fx, config.fx_delay_mix);
 }
 
 // Helper: save current RegrooveEffects instance to RSX effects settings
@@ -382,6 +381,47 @@ void save_note_suppression_to_rsx() {
     samplecrate_rsx_save(rsx, rsx_file_path.c_str());
 }
 
+// Kit load progress (called from the engine's loading threads)
+static void kit_load_progress(int loaded, int total, void* userdata) {
+    kit_load_loaded = loaded;
+    kit_load_total = total;
+}
+
+void reload_sequences();
+void pad_visual_feedback(int pad_index, int note, int velocity, int on);
+
+// Finish a background kit load once the engine has swapped it in (UI loop, every frame)
+static void poll_kit_load() {
+    if (!kit_loading) return;
+
+    SamplecrateKitLoadState state = samplecrate_engine_poll_rsx_load(engine);
+    if (state == ENGINE_KIT_LOAD_BUSY) return;
+    kit_loading = false;
+
+    if (state == ENGINE_KIT_LOAD_DONE) {
+        printf("[File Browser] Successfully loaded: %s\n", kit_load_path.c_str());
+        rsx_file_path = kit_load_path;  // Update current file path
+
+        // Sequences of the old kit stop here (they played on while loading)
+        if (performance) {
+            medness_performance_stop_all(performance);
+        }
+        if (sequence_manager) {
+            medness_performance_stop_all(sequence_manager);
+        }
+
+        reload_sequences();  // Load sequences from RSX
+
+        // Load MIDI files for pads (engine handles routing, provides visual feedback callback)
+        samplecrate_engine_load_pads(engine, pad_visual_feedback);
+
+        // Exit browse mode after successful load
+        file_browser_mode = false;
+    } else {
+        printf("[File Browser] Failed to load: %s\n", kit_load_path.c_str());
+    }
+}
+
 // Helper: reload sequences from RSX structure (in memory)
 void reload_sequences() {
     if (!sequence_manager || !rsx) return;
@@ -417,6 +457,14 @@ void autosave_effects_to_rsx() {
         rsx->program_fx_enable[i] = mixer.program_fx_enable[i];
     }
 
+    // Save aux send/return levels (set from the mixer strip or SysEx)
+    for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
+        rsx->program_delay_sends[i] = mixer.program_delay_sends[i];
+        rsx->program_reverb_sends[i] = mixer.program_reverb_sends[i];
+    }
+    rsx->delay_return = mixer.delay_return;
+    rsx->reverb_return = mixer.reverb_return;
+
     // Save master effects
     if (effects_master) {
         save_instance_to_rsx_effects(effects_master, &rsx->master_effects);
@@ -488,8 +536,6 @@ void switch_program(int program_index) {
     if (!rsx || program_index < 0 || program_index >= rsx->num_programs) return;
     if (!program_synths[program_index]) return;  // Program not loaded
 
-    current_program = program_index;
-
     // Update midi_target_program for all devices when program changes via UI
     // If a device has program change enabled, it can still be overridden by MIDI messages
     // But UI selection should update all devices by default
@@ -499,9 +545,8 @@ void switch_program(int program_index) {
 
     std::cout << "Switching to program " << (program_index + 1) << ": " << rsx->program_files[program_index] << std::endl;
 
-    // Switch synth pointer to the selected program
-    std::lock_guard<std::mutex> lock(synth_mutex);
-    synth = program_synths[program_index];
+    // The audio thread switches the synth pointer at its next block
+    samplecrate_engine_switch_program(engine, program_index);
     error_message = "";  // Clear any previous errors
 }
 
@@ -671,11 +716,10 @@ void handle_input_event(InputEvent* event) {
                         target_synth = program_synths[target_prog];
                     }
 
-                    std::lock_guard<std::mutex> lock(synth_mutex);
                     if (target_synth) {
                         // For CC triggers, just send note_on (no release event available)
                         // The SFZ file's envelope/release settings will control the sound
-                        sfizz_send_note_on(target_synth, 0, pad->note, velocity);
+                        samplecrate_engine_queue_note(engine, actual_program, pad->note, velocity, 1);
 
                         current_note = pad->note;
                         current_velocity = velocity;
@@ -837,10 +881,9 @@ void handle_input_event(InputEvent* event) {
 }
 
 // Helper: get current time in microseconds
+// Same clock as MIDI input timestamps, so both can be compared
 static uint64_t get_microseconds() {
-    return std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()
-    ).count();
+    return midi_get_time_us();
 }
 
 // Helper: build sequence slot state (mute bits, flags, program assignments)
@@ -1026,6 +1069,33 @@ void sysex_callback(uint8_t device_id, SysExCommand command, const uint8_t *data
             break;
         }
 
+        case SYSEX_CMD_CHANNEL_DELAY_SEND:
+        case SYSEX_CMD_CHANNEL_REVERB_SEND: {
+            // F0 7D <dev> 5A <program_id> <level> F7 (delay)
+            // F0 7D <dev> 5B <program_id> <level> F7 (reverb)
+            bool is_delay = (command == SYSEX_CMD_CHANNEL_DELAY_SEND);
+            if (data_len < 2) {
+                printf("[SysEx] %s: insufficient data\n", sysex_command_name(command));
+                break;
+            }
+
+            uint8_t program_id = data[0];
+            uint8_t level = data[1];
+
+            if (program_id >= RSX_MAX_PROGRAMS) {
+                printf("[SysEx] %s: invalid program ID %d\n", sysex_command_name(command), program_id);
+                break;
+            }
+
+            if (engine) {
+                float* sends = is_delay ? mixer.program_delay_sends : mixer.program_reverb_sends;
+                sends[program_id] = level / 127.0f;
+                printf("[SysEx] %s: program %d %s send set to %.2f\n", sysex_command_name(command),
+                       program_id, is_delay ? "delay" : "reverb", sends[program_id]);
+            }
+            break;
+        }
+
         case SYSEX_CMD_CHANNEL_MUTE: {
             // F0 7D <dev> 30 <program_id> <mute> F7
             if (data_len < 2) {
@@ -1130,7 +1200,7 @@ void sysex_callback(uint8_t device_id, SysExCommand command, const uint8_t *data
 
             if (program_id >= RSX_MAX_PROGRAMS) break;
 
-            RegrooveEffects* prog_fx = (program_id < RSX_MAX_PROGRAMS && engine) ? engine->effects_program[program_id] : nullptr;
+            RegrooveEffects* prog_fx = engine ? samplecrate_engine_ensure_program_effects(engine, program_id) : nullptr;
             if (!prog_fx) break;
 
             RegrooveEffects* fx = prog_fx;
@@ -1212,7 +1282,8 @@ void sysex_callback(uint8_t device_id, SysExCommand command, const uint8_t *data
 
             if (program_id >= RSX_MAX_PROGRAMS) break;
 
-            RegrooveEffects* prog_fx_get = (program_id < RSX_MAX_PROGRAMS && engine) ? engine->effects_program[program_id] : nullptr;
+            // Chains are created lazily: make one (with the defaults) so untouched programs still reply
+            RegrooveEffects* prog_fx_get = engine ? samplecrate_engine_ensure_program_effects(engine, program_id) : nullptr;
             if (!prog_fx_get) break;
 
             RegrooveEffects* fx = prog_fx_get;
@@ -1284,7 +1355,8 @@ void sysex_callback(uint8_t device_id, SysExCommand command, const uint8_t *data
 
             if (program_id >= RSX_MAX_PROGRAMS) break;
 
-            RegrooveEffects* prog_fx_all = (program_id < RSX_MAX_PROGRAMS && engine) ? engine->effects_program[program_id] : nullptr;
+            // Chains are created lazily: make one (with the defaults) so untouched programs still reply
+            RegrooveEffects* prog_fx_all = engine ? samplecrate_engine_ensure_program_effects(engine, program_id) : nullptr;
             if (!prog_fx_all) break;
 
             RegrooveEffects* fx = prog_fx_all;
@@ -1968,7 +2040,8 @@ void sysex_callback(uint8_t device_id, SysExCommand command, const uint8_t *data
 }
 
 // MIDI event callback from midi.c
-void midi_event_callback(unsigned char status, unsigned char data1, unsigned char data2, int device_id, void* userdata) {
+void midi_event_callback(unsigned char status, unsigned char data1, unsigned char data2, int device_id,
+                         uint64_t timestamp_us, void* userdata) {
     int msg_type = status & 0xF0;
     int channel = status & 0x0F;
 
@@ -2028,7 +2101,8 @@ void midi_event_callback(unsigned char status, unsigned char data1, unsigned cha
 
     // Handle MIDI Clock messages (Real-Time messages - these don't have channels)
     if (status == 0xF8) {  // MIDI Clock (24 ppqn - pulses per quarter note)
-        uint64_t now = get_microseconds();
+        // Driver timestamp of the pulse, not the time this callback got to run
+        uint64_t now = timestamp_us;
 
         // Debug: Count clock pulses and show rate every second
         static int total_clock_pulses = 0;
@@ -2046,144 +2120,94 @@ void midi_event_callback(unsigned char status, unsigned char data1, unsigned cha
         if (now - last_report_time >= 1000000) {  // 1 second in microseconds
             std::cout << "[MIDI CLOCK] Received " << pulses_this_second
                       << " pulses in last second (total: " << total_clock_pulses
-                      << ", device_id=" << device_id << ")" << std::endl;
+                      << ", device_id=" << device_id
+                      << ", " << (midi_clock_pll_is_locked(&midi_clock.pll) ? "locked" : "acquiring")
+                      << ", jitter=" << midi_clock_pll_get_jitter_us(&midi_clock.pll) << "us"
+                      << ", phase_error=" << midi_clock.phase_error << " pulses)" << std::endl;
             pulses_this_second = 0;
             last_report_time = now;
         }
 
+        // The clock timed out in the meantime: reacquire from this pulse
+        // (the PLL belongs to this thread, the audio thread only asks)
+        if (__atomic_exchange_n(&midi_clock.pll_reset_requested, 0, __ATOMIC_ACQ_REL)) {
+            midi_clock_pll_reset(&midi_clock.pll);
+            midi_clock.pulse_count = 0;
+        }
+
         // First MIDI clock pulse - start tracking tempo for BPM adjustment
         if (sequencer && !midi_clock.active) {
-            // std::cout << "[MIDI CLOCK] First clock pulse - starting BPM tracking" << std::endl;
-            // Sequencer always uses internal clock - MIDI clock only adjusts BPM (no external_clock mode)
-
-            // Reset BPM smoothing filter when first receiving external clock
-            // This ensures we start fresh with the new tempo source
+            // Sequencer always uses internal clock - MIDI clock corrects its tempo and phase
+            midi_clock_pll_reset(&midi_clock.pll);
             midi_clock.bpm = 0.0f;
-            midi_clock.smoothed_bpm = 0.0f;
         }
 
-        if (midi_clock.last_clock_time > 0) {
-            uint64_t interval = now - midi_clock.last_clock_time;
+        // DON'T forward clock pulse to sequencer - sequencer uses internal clock only
+        // (This was causing double-speed playback when both clocks were active)
+        // Instead the PLL recovers the master's tempo and phase from the pulse
+        // timestamps and steers the internal clock towards them.
+        int advanced = midi_clock_pll_pulse(&midi_clock.pll, timestamp_us);
+        int lost = (advanced > 1) ? advanced - 1 : 0;
 
-            // DON'T forward clock pulse to sequencer - sequencer uses internal clock only
-            // External MIDI clock only adjusts BPM, doesn't control position
-            // (This was causing double-speed playback when both clocks were active)
+        // Master song position of this pulse (lost pulses still moved the master on)
+        int64_t song_pulse = midi_clock.next_song_pulse + lost;
+        midi_clock.next_song_pulse = song_pulse + 1;
 
+        if (midi_clock.last_clock_time > 0) {
             // Increment total pulse count for sub-beat precision (for SPP calculations)
-            midi_clock.total_pulse_count++;
-
-            // Calculate BPM every 24 pulses (one quarter note)
-            midi_clock.pulse_count++;
-            if (midi_clock.pulse_count >= 24) {
-                uint64_t total_time = now - midi_clock.last_bpm_calc_time;
-                // BPM = (60,000,000 microseconds/minute) / (time for one quarter note in microseconds)
-                if (total_time > 0) {
-                    float raw_bpm = 60000000.0f / total_time;
-
-                    // Reject extreme BPM values that are too far from current tempo
-                    // This prevents sync glitches (timeouts, gaps) from causing wild tempo swings
-                    // Accept range: ±20% of current BPM (e.g., 100-150 BPM if current is 125)
-                    // EXCEPTION: If we get 3 consecutive readings at the same BPM, accept it
-                    // (this indicates an intentional tempo change, not a glitch)
-                    const float BPM_CHANGE_THRESHOLD = 0.20f;  // 20% tolerance
-                    const int CONSECUTIVE_ACCEPT_COUNT = 3;     // Accept after 3 consistent readings
-                    bool accept_bpm = true;
-
-                    if (midi_clock.smoothed_bpm > 0.0f) {  // Have existing tempo reference
-                        float change_ratio = fabs(raw_bpm - midi_clock.smoothed_bpm) / midi_clock.smoothed_bpm;
-                        if (change_ratio > BPM_CHANGE_THRESHOLD) {
-                            // Check if this BPM is similar to previously rejected values
-                            // (within 5% of last rejected BPM = consistent reading)
-                            bool is_consistent = false;
-                            if (midi_clock.last_rejected_bpm > 0.0f) {
-                                float rejection_similarity = fabs(raw_bpm - midi_clock.last_rejected_bpm) / midi_clock.last_rejected_bpm;
-                                is_consistent = (rejection_similarity < 0.05f);  // Within 5% = same tempo
-                            }
-
-                            if (is_consistent) {
-                                midi_clock.consecutive_rejections++;
-
-                                // After N consecutive rejections of the same BPM, accept it
-                                if (midi_clock.consecutive_rejections >= CONSECUTIVE_ACCEPT_COUNT) {
-                                    std::cout << "[MIDI CLOCK] Accepting BPM " << raw_bpm
-                                              << " after " << midi_clock.consecutive_rejections << " consistent readings "
-                                              << "(change: " << (change_ratio * 100.0f) << "% from " << midi_clock.smoothed_bpm << ")" << std::endl;
-                                    accept_bpm = true;
-                                    midi_clock.consecutive_rejections = 0;  // Reset counter
-                                    midi_clock.last_rejected_bpm = 0.0f;
-                                } else {
-                                    std::cout << "[MIDI CLOCK] Rejecting BPM " << raw_bpm
-                                              << " (change: " << (change_ratio * 100.0f) << "% from " << midi_clock.smoothed_bpm
-                                              << ", threshold: " << (BPM_CHANGE_THRESHOLD * 100.0f) << "%, "
-                                              << midi_clock.consecutive_rejections << "/" << CONSECUTIVE_ACCEPT_COUNT << " consistent)" << std::endl;
-                                    accept_bpm = false;
-                                    midi_clock.last_rejected_bpm = raw_bpm;  // Track this rejection
-                                }
-                            } else {
-                                // Different BPM than before - reset counter
-                                std::cout << "[MIDI CLOCK] Rejecting BPM " << raw_bpm
-                                          << " (change: " << (change_ratio * 100.0f) << "% from " << midi_clock.smoothed_bpm
-                                          << ", threshold: " << (BPM_CHANGE_THRESHOLD * 100.0f) << "%)" << std::endl;
-                                accept_bpm = false;
-                                midi_clock.consecutive_rejections = 1;
-                                midi_clock.last_rejected_bpm = raw_bpm;
-                            }
-                        } else {
-                            // BPM within threshold - reset rejection tracking
-                            midi_clock.consecutive_rejections = 0;
-                            midi_clock.last_rejected_bpm = 0.0f;
-                        }
-                    }
-
-                    float new_bpm = midi_clock.smoothed_bpm;  // Default: keep current
-
-                    if (accept_bpm) {
-                        // Smooth BPM using exponential moving average to reduce jitter
-                        // Alpha = 0.3 gives moderate smoothing (lower = more smoothing)
-                        if (midi_clock.smoothed_bpm == 0.0f) {
-                            midi_clock.smoothed_bpm = raw_bpm;  // Initialize on first reading
-                        } else {
-                            midi_clock.smoothed_bpm = midi_clock.smoothed_bpm * 0.7f + raw_bpm * 0.3f;  // Exponential moving average
-                        }
+            midi_clock.total_pulse_count += 1 + lost;
 
-                        new_bpm = midi_clock.smoothed_bpm;
-                    }
+            midi_clock.pulse_count += 1 + lost;
+            while (midi_clock.pulse_count >= 24) {
+                midi_clock.pulse_count -= 24;
+                midi_clock.beat_count++;  // Increment beat counter
+            }
+        }
 
-                    // Only update BPM and apply changes if we accepted this reading
-                    if (accept_bpm) {
-                        bool bpm_changed = fabs(new_bpm - midi_clock.bpm) > 0.1f;
-                        midi_clock.bpm = new_bpm;
+        float pll_bpm = midi_clock_pll_get_bpm(&midi_clock.pll);
+        if (pll_bpm > 0.0f) {
+            bool bpm_changed = fabs(pll_bpm - midi_clock.bpm) > 0.1f;
+            if (bpm_changed) {
+                std::cout << "MIDI CLOCK: BPM = " << pll_bpm
+                          << " (" << (midi_clock_pll_is_locked(&midi_clock.pll) ? "locked" : "acquiring") << ")" << std::endl;
+            }
 
-                        if (bpm_changed) {
-                            std::cout << "MIDI CLOCK: BPM = " << new_bpm
-                                      << " (raw: " << raw_bpm << ", smoothed, interval=" << total_time << "us)" << std::endl;
-                        }
+            // Follow the recovered tempo continuously (it is already filtered)
+            bool tempo_moved = fabs(pll_bpm - midi_clock.bpm) > 0.001f;
+            midi_clock.bpm = pll_bpm;
 
-                        // Always update active playback tempo if sync is enabled
-                        if (config.midi_clock_tempo_sync == 1) {
-                            active_bpm = midi_clock.bpm;  // Update active playback tempo
-                            tempo_bpm = midi_clock.bpm;   // Update UI slider to match
+            // Always update active playback tempo if sync is enabled
+            if (config.midi_clock_tempo_sync == 1) {
+                active_bpm = midi_clock.bpm;  // Update active playback tempo
+                tempo_bpm = midi_clock.bpm;   // Update UI slider to match
 
-                            // Only update sequencer/player if BPM actually changed
-                            if (bpm_changed && performance) {
-                                if (sequencer) {
-                                    medness_sequencer_set_bpm(sequencer, active_bpm);
-                                }
-                                medness_performance_set_tempo(performance, active_bpm);
-                                if (sequence_manager) {
-                                    medness_performance_set_tempo(sequence_manager, active_bpm);
-                                }
-                                std::cout << "  -> active_bpm/tempo_bpm updated to " << active_bpm << std::endl;
-                            }
-                        }
+                if (tempo_moved && performance) {
+                    if (sequencer) {
+                        medness_sequencer_set_bpm(sequencer, active_bpm);
+                    }
+                    medness_performance_set_tempo(performance, active_bpm);
+                    if (sequence_manager) {
+                        medness_performance_set_tempo(sequence_manager, active_bpm);
                     }
                 }
-                midi_clock.pulse_count = 0;
-                midi_clock.beat_count++;  // Increment beat counter
-                midi_clock.last_bpm_calc_time = now;
+
+                // Phase: compare where the sequencer was at the (filtered) pulse
+                // time with where the master is, and steer it over a few pulses
+                double sequencer_pulse = 0.0;
+                if (sequencer && midi_clock.position_known && midi_clock_pll_is_locked(&midi_clock.pll) &&
+                    medness_sequencer_get_position_at(sequencer, midi_clock_pll_get_pulse_time(&midi_clock.pll),
+                                                      &sequencer_pulse) == 0) {
+                    // Shortest way round the pattern (the sequencer loops, the master counts on)
+                    double pattern_pulses = (double)medness_sequencer_get_pattern_length(sequencer);
+                    float error = (float)remainder((double)song_pulse - sequencer_pulse, pattern_pulses);
+                    midi_clock.phase_error = error;
+
+                    float step = error * MIDI_CLOCK_PHASE_GAIN;
+                    if (step > MIDI_CLOCK_PHASE_MAX_STEP) step = MIDI_CLOCK_PHASE_MAX_STEP;
+                    if (step < -MIDI_CLOCK_PHASE_MAX_STEP) step = -MIDI_CLOCK_PHASE_MAX_STEP;
+                    medness_sequencer_adjust_phase(sequencer, step);
+                }
             }
-        } else {
-            midi_clock.last_bpm_calc_time = now;
         }
 
         midi_clock.last_clock_time = now;
@@ -2196,8 +2220,9 @@ void midi_event_callback(unsigned char status, unsigned char data1, unsigned cha
         midi_clock.pulse_count = 0;
         midi_clock.beat_count = 0;  // Reset beat counter on start
         midi_clock.total_pulse_count = 0;  // Reset total pulse count for precise sync
-        midi_clock.last_bpm_calc_time = get_microseconds();
         midi_clock.last_clock_time = 0;  // Reset to get fresh timing on first pulse
+        midi_clock.next_song_pulse = 0;  // First pulse after Start is song position 0
+        midi_clock.position_known = true;
         // Don't reset BPM here - keep displaying last known BPM until new one is calculated
 
         // Don't enable external clock mode yet - wait for first 0xF8 pulse
@@ -2211,10 +2236,10 @@ void midi_event_callback(unsigned char status, unsigned char data1, unsigned cha
 
         // Reset BPM calculation state to prevent huge jumps on restart
         midi_clock.last_clock_time = 0;
-        midi_clock.last_bpm_calc_time = 0;
         midi_clock.pulse_count = 0;
         midi_clock.bpm = 0.0f;  // Reset BPM to prevent displaying stale values
-        midi_clock.smoothed_bpm = 0.0f;  // Reset smoothing filter
+        midi_clock_pll_reset(&midi_clock.pll);  // Reacquire on restart
+        midi_clock.phase_error = 0.0f;
 
         // Sequencer continues on internal clock (no external_clock mode to switch)
         // Just stop receiving BPM adjustments from MIDI clock
@@ -2231,6 +2256,10 @@ void midi_event_callback(unsigned char status, unsigned char data1, unsigned cha
         int spp_position = data1 | (data2 << 7);
         midi_clock.spp_position = spp_position;
 
+        // The master continues from here: its next clock pulse is at this position
+        midi_clock.next_song_pulse = (int64_t)spp_position * 6;
+        midi_clock.position_known = true;
+
         // std::cout << "DEBUG: SPP handler called, raw position=" << spp_position
         //           << ", config.midi_spp_receive=" << config.midi_spp_receive << std::endl;
 
@@ -2253,11 +2282,11 @@ void midi_event_callback(unsigned char status, unsigned char data1, unsigned cha
             midi_clock.last_clock_time = get_microseconds();
 
             // SPP tells us the PATTERN POSITION (row in the pattern)
-            // SPP is in 16th notes (0-63 for a 4-bar pattern)
+            // SPP is in 16th notes (0-63 for a 4-bar 4/4 pattern)
             // We convert to pulses: each 16th note = 6 MIDI clock pulses
-            // Pattern position just CYCLES 0-383 pulses
-            const int PATTERN_LENGTH_SIXTEENTHS = 64;
-            const int PATTERN_LENGTH_PULSES = 384;
+            // Pattern position just CYCLES through the pattern length in pulses
+            const int PATTERN_LENGTH_SIXTEENTHS = medness_sequencer_get_pattern_rows(sequencer);
+            const int PATTERN_LENGTH_PULSES = medness_sequencer_get_pattern_length(sequencer);
 
             // SPP position within pattern (cycles 0-63)
             int spp_within_pattern = spp_position % PATTERN_LENGTH_SIXTEENTHS;
@@ -2421,11 +2450,10 @@ void midi_event_callback(unsigned char status, unsigned char data1, unsigned cha
                         } else if (pad->note >= 0) {
                             // Single note trigger
                             int target_prog = (pad->program >= 0) ? pad->program : current_program;
-                            std::lock_guard<std::mutex> lock(synth_mutex);
                             sfizz_synth_t* target_synth = program_synths[target_prog];
                             if (target_synth) {
                                 int vel = (pad->velocity > 0) ? pad->velocity : 100;
-                                sfizz_send_note_on(target_synth, 0, pad->note, vel);
+                                samplecrate_engine_queue_note_timed(engine, target_prog, pad->note, vel, 1, timestamp_us);
                                 note_pad_fade[i] = 1.0f;
                             }
                         }
@@ -2455,11 +2483,10 @@ void midi_event_callback(unsigned char status, unsigned char data1, unsigned cha
         // Log to MIDI monitor
         add_to_midi_monitor(device_id, "Note On", data1, data2, target_prog + 1);
 
-        // Send MIDI note directly to the appropriate synth (bypass pad mapping)
-        std::lock_guard<std::mutex> lock(synth_mutex);
+        // Queue MIDI note for the appropriate synth (bypass pad mapping)
         sfizz_synth_t* target_synth = program_synths[target_prog];
         if (target_synth) {
-            sfizz_send_note_on(target_synth, 0, data1, data2);
+            samplecrate_engine_queue_note_timed(engine, target_prog, data1, data2, 1, timestamp_us);
 
             // Highlight all pads configured for this note on the target program
             if (rsx) {
@@ -2481,10 +2508,8 @@ void midi_event_callback(unsigned char status, unsigned char data1, unsigned cha
         // Log to MIDI monitor
         add_to_midi_monitor(device_id, "Note Off", data1, data2, target_prog + 1);
 
-        // Send MIDI note off directly to the appropriate synth (bypass pad mapping)
-        std::lock_guard<std::mutex> lock(synth_mutex);
-        sfizz_synth_t* target_synth = program_synths[target_prog];
-        if (target_synth) sfizz_send_note_off(target_synth, 0, data1, 0);
+        // Queue MIDI note off for the appropriate synth (bypass pad mapping)
+        samplecrate_engine_queue_note_timed(engine, target_prog, data1, 0, 0, timestamp_us);
     } else if (msg_type == 0xB0) {  // CC message
         // Check if in learn mode
         if (learn_mode_active) {
@@ -2561,14 +2586,113 @@ void midi_event_callback(unsigned char status, unsigned char data1, unsigned cha
     }
 }
 
+// Host time of the current audio block (set at the start of each callback)
+static uint64_t audio_block_time_us = 0;
+
+// Queue MIDI clock output for one audio block (audio thread)
+// playing: the sequencer played tracks this block (update() returned >= 0)
+// start_pulse/end_pulse: song position at the first frame and after the last
+// Every message is stamped with the time its frame is heard (one output
+// buffer after the block time), so pulses are evenly spaced whatever the
+// callback size and line up with the audio
+static void midi_clock_output_block(bool playing, double start_pulse, double end_pulse, int frames,
+                                    uint64_t block_time_us) {
+    int latency_frames = engine ? engine->live_latency_frames : 0;
+    uint64_t output_time_us = block_time_us + (uint64_t)latency_frames * 1000000 / 44100;
+
+    // Never lead while following an external clock (that would echo it back)
+    bool enabled = (config.midi_clock_send == 1 && !midi_clock.active);
+
+    // Transport stopped: no track playing, or the position went back to 0
+    // when the last one stopped. The slave starts again with the tracks.
+    bool stopped = !playing || end_pulse < start_pulse;
+
+    // A jump in song position (SPP seek, phase correction) restarts the slave
+    bool jumped = midi_clock_out.running && fabs(start_pulse - midi_clock_out.last_song_pulse) > 0.5;
+    midi_clock_out.last_song_pulse = end_pulse;
+
+    if (midi_clock_out.running && (!enabled || stopped || jumped)) {
+        unsigned char stop = MIDI_OUTPUT_STOP;
+        midi_output_queue_message(&stop, 1, output_time_us);
+        midi_clock_out.running = false;
+    }
+    if (!enabled || stopped) return;
+
+    if (!midi_clock_out.running) {
+        // Resume at the next 16th note: SPP counts 16ths (6 pulses)
+        int64_t sixteenth = (int64_t)ceil(start_pulse / 6.0);
+        int spp = (int)(sixteenth % 16384);
+        unsigned char spp_msg[3] = { MIDI_OUTPUT_SONG_POS, (unsigned char)(spp & 0x7F), (unsigned char)((spp >> 7) & 0x7F) };
+        unsigned char start = (sixteenth == 0) ? MIDI_OUTPUT_START : MIDI_OUTPUT_CONTINUE;
+        if (midi_output_queue_message(spp_msg, 3, output_time_us) != 0 ||
+            midi_output_queue_message(&start, 1, output_time_us) != 0) {
+            return;  // No output open (or queue full): try again next block
+        }
+        midi_clock_out.next_pulse = sixteenth * 6;
+        midi_clock_out.running = true;
+    }
+
+    double span = end_pulse - start_pulse;
+    if (span <= 0.0) return;
+
+    unsigned char clock = MIDI_OUTPUT_CLOCK;
+    while ((double)midi_clock_out.next_pulse < end_pulse) {
+        double frame = ((double)midi_clock_out.next_pulse - start_pulse) / span * frames;
+        if (frame < 0.0) frame = 0.0;
+        uint64_t pulse_time_us = output_time_us + (uint64_t)(frame * 1000000.0 / 44100.0 + 0.5);
+        if (midi_output_queue_message(&clock, 1, pulse_time_us) != 0) {
+            // Output closed under us: restart with SPP once it's back
+            midi_clock_out.running = false;
+            return;
+        }
+        midi_clock_out.next_pulse++;
+    }
+}
+
+// Sequencer slots routed to the MIDI output (audio thread, or the caller of
+// remove_track for All Notes Off). Stamped like the audio: the frame's
+// position in the block, one output buffer later.
+static void sequencer_midi_output(const MednessTrackEvent* evt, int channel, int frame_offset, void* userdata) {
+    int latency_frames = engine ? engine->live_latency_frames : 0;
+    uint64_t timestamp_us = audio_block_time_us + (uint64_t)(latency_frames + frame_offset) * 1000000 / 44100;
+
+    switch (evt->type) {
+        case MEDNESS_TRACK_EVENT_NOTE:
+            midi_output_queue_note(channel, evt->note, evt->velocity, evt->on, timestamp_us);
+            break;
+        case MEDNESS_TRACK_EVENT_CONTROL:
+            midi_output_queue_cc(channel, evt->note, evt->velocity, timestamp_us);
+            break;
+        case MEDNESS_TRACK_EVENT_PROGRAM:
+            midi_output_queue_program(channel, evt->note, timestamp_us);
+            break;
+    }
+}
+
 // SDL audio callback
 void audioCallback(void* userdata, Uint8* stream, int len) {
+    // Debug builds trap heap allocations anywhere in the callback
+    samplecrate_rt_guard_begin();
+
     float* out = reinterpret_cast<float*>(stream);
     int frames = len / (sizeof(float) * 2); // stereo
 
-    // Update MIDI file playback BEFORE acquiring the lock
+    // Host time of this block (sequencer position queries, timed live notes,
+    // clock output). Callbacks should come exactly one buffer apart; follow
+    // the measured time only loosely so callback scheduling jitter doesn't
+    // turn into timing jitter.
+    uint64_t callback_time_us = get_microseconds();
+    int64_t block_duration_us = (int64_t)frames * 1000000 / 44100;
+    int64_t expected_us = (int64_t)audio_block_time_us + block_duration_us;
+    int64_t deviation_us = (int64_t)callback_time_us - expected_us;
+    if (audio_block_time_us == 0 || deviation_us > block_duration_us || deviation_us < -block_duration_us) {
+        audio_block_time_us = callback_time_us;  // First block or a dropout: start over
+    } else {
+        audio_block_time_us = (uint64_t)(expected_us + deviation_us / 16);
+    }
+
+    // Update MIDI file playback
     // This runs in the audio thread for perfect timing (no UI blocking!)
-    // The MIDI event callbacks will acquire the lock themselves
     if (performance) {
         // Check for MIDI clock timeout (stop showing [SYNC] but keep BPM)
         // Internal clock continues at last known BPM - we never "fall back"
@@ -2582,15 +2706,14 @@ void audioCallback(void* userdata, Uint8* stream, int len) {
                 // Internal clock continues at last known BPM
                 if (midi_clock.active) {
                     printf("[MIDI CLOCK] Sync lost (no pulses for %llu us) - continuing at last BPM %.1f\n",
-                           (unsigned long long)time_since_last_pulse, midi_clock.smoothed_bpm);
+                           (unsigned long long)time_since_last_pulse, midi_clock.bpm);
                 }
                 midi_clock.active = false;
 
-                // Reset smoothing filter to prevent stale data from corrupting next sync
-                // When clock reconnects, the first pulse will have a huge interval (time since last pulse)
-                // which would calculate an extremely slow BPM. By resetting the filter, we start fresh.
-                midi_clock.smoothed_bpm = 0.0f;
-                midi_clock.pulse_count = 0;  // Reset pulse counter too
+                // Have the MIDI thread reset the clock PLL (and pulse counter) so
+                // it reacquires when the clock reconnects (the first pulse after
+                // a gap says nothing about the tempo)
+                __atomic_store_n(&midi_clock.pll_reset_requested, 1, __ATOMIC_RELEASE);
 
                 // Keep running state and BPM - internal clock continues
                 // DON'T call medness_sequencer_set_external_clock - sequencer always uses internal clock
@@ -2603,7 +2726,13 @@ void audioCallback(void* userdata, Uint8* stream, int len) {
         if (sequencer && medness_sequencer_is_active(sequencer)) {
             // Update sequencer - always advances based on internal clock at current BPM
             // MIDI clock pulses adjust the BPM but don't directly control position
+            // Pending settings (SPP seeks) first, so the block starts where it plays from
+            medness_sequencer_update(sequencer, 0, 44100);
+            double block_start_pulse = medness_sequencer_get_song_position(sequencer);
+            medness_sequencer_set_block_time(sequencer, audio_block_time_us);
             current_pulse = medness_sequencer_update(sequencer, frames, 44100);
+            midi_clock_output_block(current_pulse >= 0, block_start_pulse,
+                                    medness_sequencer_get_song_position(sequencer), frames, audio_block_time_us);
 
             // Debug: log first 10 pulses immediately, then every 96 pulses
             static int debug_pulse_count = 0;
@@ -2638,116 +2767,17 @@ void audioCallback(void* userdata, Uint8* stream, int len) {
         }
     }
 
-    std::lock_guard<std::mutex> lock(synth_mutex);
-
-    // Create temporary buffers for left and right channels
-    std::vector<float> left(frames, 0.0f);
-    std::vector<float> right(frames, 0.0f);
-
-    // If we have multiple program synths loaded, mix them all together
-    if (rsx && rsx->num_programs > 0) {
-        std::vector<float> prog_left(frames);
-        std::vector<float> prog_right(frames);
-
-        for (int i = 0; i < rsx->num_programs; i++) {
-            if (!program_synths[i]) continue;
-
-            // Clear program buffers
-            std::fill(prog_left.begin(), prog_left.end(), 0.0f);
-            std::fill(prog_right.begin(), prog_right.end(), 0.0f);
-            float* prog_channels[2] = { prog_left.data(), prog_right.data() };
-
-            // Render this program's audio
-            sfizz_render_block(program_synths[i], prog_channels, 2, frames);
-
-            // Apply per-program FX if enabled (pre-fader)
-            if (engine->effects_program[i] && mixer.program_fx_enable[i]) {
-                std::vector<int16_t> int16_buf(frames * 2);
-                for (int j = 0; j < frames; j++) {
-                    int16_buf[j * 2] = static_cast<int16_t>(prog_left[j] * 32767.0f);
-                    int16_buf[j * 2 + 1] = static_cast<int16_t>(prog_right[j] * 32767.0f);
-                }
-                regroove_effects_process(engine->effects_program[i], int16_buf.data(), frames, 44100);
-                for (int j = 0; j < frames; j++) {
-                    prog_left[j] = int16_buf[j * 2] / 32767.0f;
-                    prog_right[j] = int16_buf[j * 2 + 1] / 32767.0f;
-                }
-            }
-
-            // Apply per-program pan
-            float prog_pan = mixer.program_pans[i];
-            float prog_left_gain = 1.0f - prog_pan;
-            float prog_right_gain = prog_pan;
-
-            // Apply per-program volume and mute
-            float prog_vol = mixer.program_mutes[i] ? 0.0f : mixer.program_volumes[i];
-            for (int j = 0; j < frames; j++) {
-                prog_left[j] *= prog_vol * prog_left_gain;
-                prog_right[j] *= prog_vol * prog_right_gain;
-            }
-
-            // Mix into main buffers
-            for (int j = 0; j < frames; j++) {
-                left[j] += prog_left[j];
-                right[j] += prog_right[j];
-            }
-        }
-    } else if (synth) {
-        // Single synth mode (no programs)
-        float* channels[2] = { left.data(), right.data() };
-        sfizz_render_block(synth, channels, 2, frames);
-    }
-
-    // Apply playback volume and pan
-    // Pan: 0.0 = left, 0.5 = center (both at 100%), 1.0 = right
-    float playback_vol = mixer.playback_mute ? 0.0f : mixer.playback_volume;
-    float playback_pan = mixer.playback_pan;
-
-    // Constant-power panning: center should be full volume on both channels
-    float playback_left_gain = playback_vol * (playback_pan <= 0.5f ? 1.0f : (1.0f - (playback_pan - 0.5f) * 2.0f));
-    float playback_right_gain = playback_vol * (playback_pan >= 0.5f ? 1.0f : (playback_pan * 2.0f));
-
-    for (int i = 0; i < frames; i++) {
-        left[i] *= playback_left_gain;
-        right[i] *= playback_right_gain;
-    }
-
-    // Apply master volume and pan
-    float master_vol = mixer.master_mute ? 0.0f : mixer.master_volume;
-    float master_pan = mixer.master_pan;
-
-    // Constant-power panning: center should be full volume on both channels
-    float master_left_gain = master_vol * (master_pan <= 0.5f ? 1.0f : (1.0f - (master_pan - 0.5f) * 2.0f));
-    float master_right_gain = master_vol * (master_pan >= 0.5f ? 1.0f : (master_pan * 2.0f));
-
-    for (int i = 0; i < frames; i++) {
-        left[i] *= master_left_gain;
-        right[i] *= master_right_gain;
+    // Apply note events queued by MIDI/UI/sequencer threads (lock-free)
+    if (engine) {
+        int first_slice = frames < engine->scratch_frames ? frames : engine->scratch_frames;
+        samplecrate_engine_drain_events(engine, first_slice, audio_block_time_us);
     }
 
-    // Apply master effects if enabled
-    if (effects_master && mixer.master_fx_enable) {
-        // Convert float to int16 for effects
-        std::vector<int16_t> int16_buf(frames * 2);
-        for (int i = 0; i < frames; i++) {
-            int16_buf[i * 2] = static_cast<int16_t>(left[i] * 32767.0f);
-            int16_buf[i * 2 + 1] = static_cast<int16_t>(right[i] * 32767.0f);
-        }
-
-        regroove_effects_process(effects_master, int16_buf.data(), frames, 44100);
-
-        // Convert back to float
-        for (int i = 0; i < frames; i++) {
-            left[i] = int16_buf[i * 2] / 32767.0f;
-            right[i] = int16_buf[i * 2 + 1] / 32767.0f;
-        }
-    }
+    // Full mix (programs, FX, aux buses, master), rendered by the engine in
+    // slices of its scratch arena; nothing here allocates
+    samplecrate_engine_render_audio_interleaved(engine, out, frames);
 
-    // Interleave the channels into the output buffer
-    for (int i = 0; i < frames; i++) {
-        out[i * 2] = left[i];
-        out[i * 2 + 1] = right[i];
-    }
+    samplecrate_rt_guard_end();
 }
 
 // MIDI file loop restart callback - triggers visual blink
@@ -2782,15 +2812,7 @@ void pad_visual_feedback(int pad_index, int note, int velocity, int on) {
 }
 
 // MIDI file player callback for sequences (not pads)
-// Context for MIDI callbacks - includes sequence index and program number
-struct SequenceMIDIContext {
-    int seq_index;   // Sequence index (for mute/solo checking)
-    int program;     // Target program number
-};
-
-void midi_file_event_callback(int note, int velocity, int on, void* userdata) {
-    std::lock_guard<std::mutex> lock(synth_mutex);
-
+void midi_file_event_callback(int note, int velocity, int on, int frame_offset, void* userdata) {
     // Extract sequence index and program from userdata
     int seq_index = -1;
     int target_program = current_program;  // Default: follow UI
@@ -2818,15 +2840,8 @@ void midi_file_event_callback(int note, int velocity, int on, void* userdata) {
 
     // printf("[MIDI CALLBACK] note=%d vel=%d on=%d program=%d\n", note, velocity, on, target_program);
 
-    // Send to target program synth
-    sfizz_synth_t* target_synth = program_synths[target_program];
-    if (target_synth) {
-        if (on) {
-            sfizz_send_note_on(target_synth, 0, note, velocity);
-        } else {
-            sfizz_send_note_off(target_synth, 0, note, 0);
-        }
-    }
+    // Queue for target program synth (applied in the next render, at frame_offset)
+    samplecrate_engine_queue_note_at(engine, target_program, note, velocity, on, frame_offset);
 }
 
 int main(int argc, char* argv[]) {
@@ -2834,6 +2849,7 @@ int main(int argc, char* argv[]) {
     midi_clock.active = false;
     midi_clock.running = false;
     midi_clock.last_clock_time = 0;
+    midi_clock_pll_init(&midi_clock.pll, MIDI_CLOCK_PLL_BANDWIDTH);
     std::cout << "[STARTUP] Forcing internal clock mode (midi_clock.active=false)" << std::endl;
 
     // Check for SFZ or RSX file argument
@@ -2991,6 +3007,7 @@ int main(int argc, char* argv[]) {
     if (sequencer) {
         medness_sequencer_set_bpm(sequencer, 125.0f);  // Default BPM
         medness_sequencer_set_active(sequencer, 1);    // Always active
+        medness_sequencer_set_midi_output_callback(sequencer, sequencer_midi_output, nullptr);
         // Sequencer always uses internal clock - external MIDI clock only adjusts BPM
     }
 
@@ -3008,57 +3025,10 @@ int main(int argc, char* argv[]) {
     mixer.playback_volume = config.default_playback_volume;
     mixer.playback_pan = config.default_playback_pan;
 
-    // Apply config defaults to effects (created by engine)
-    if (effects_master) {
-        regroove_effects_set_distortion_drive(effects_master, config.fx_distortion_drive);
-        regroove_effects_set_distortion_mix(effects_master, config.fx_distortion_mix);
-        regroove_effects_set_filter_cutoff(effects_master, config.fx_filter_cutoff);
-        regroove_effects_set_filter_resonance(effects_master, config.fx_filter_resonance);
-        regroove_effects_set_eq_low(effects_master, config.fx_eq_low);
-        regroove_effects_set_eq_mid(effects_master, config.fx_eq_mid);
-        regroove_effects_set_eq_high(effects_master, config.fx_eq_high);
-        regroove_effects_set_compressor_threshold(effects_master, config.fx_compressor_threshold);
-        regroove_effects_set_compressor_ratio(effects_master, config.fx_compressor_ratio);
-        regroove_effects_set_compressor_attack(effects_master, config.fx_compressor_attack);
-        regroove_effects_set_compressor_release(effects_master, config.fx_compressor_release);
-        regroove_effects_set_compressor_makeup(effects_master, config.fx_compressor_makeup);
-        regroove_effects_set_phaser_rate(effects_master, config.fx_phaser_rate);
-        regroove_effects_set_phaser_depth(effects_master, config.fx_phaser_depth);
-        regroove_effects_set_phaser_feedback(effects_master, config.fx_phaser_feedback);
-        regroove_effects_set_reverb_room_size(effects_master, config.fx_reverb_room_size);
-        regroove_effects_set_reverb_damping(effects_master, config.fx_reverb_damping);
-        regroove_effects_set_reverb_mix(effects_master, config.fx_reverb_mix);
-        regroove_effects_set_delay_time(effects_master, config.fx_delay_time);
-        regroove_effects_set_delay_feedback(effects_master, config.fx_delay_feedback);
-        regroove_effects_set_delay_mix(effects_master, config.fx_delay_mix);
-    }
-
-    // Apply config defaults to per-program effects
-    for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
-        if (engine->effects_program[i]) {
-            regroove_effects_set_distortion_drive(engine->effects_program[i], config.fx_distortion_drive);
-            regroove_effects_set_distortion_mix(engine->effects_program[i], config.fx_distortion_mix);
-            regroove_effects_set_filter_cutoff(engine->effects_program[i], config.fx_filter_cutoff);
-            regroove_effects_set_filter_resonance(engine->effects_program[i], config.fx_filter_resonance);
-            regroove_effects_set_eq_low(engine->effects_program[i], config.fx_eq_low);
-            regroove_effects_set_eq_mid(engine->effects_program[i], config.fx_eq_mid);
-            regroove_effects_set_eq_high(engine->effects_program[i], config.fx_eq_high);
-            regroove_effects_set_compressor_threshold(engine->effects_program[i], config.fx_compressor_threshold);
-            regroove_effects_set_compressor_ratio(engine->effects_program[i], config.fx_compressor_ratio);
-            regroove_effects_set_compressor_attack(engine->effects_program[i], config.fx_compressor_attack);
-            regroove_effects_set_compressor_release(engine->effects_program[i], config.fx_compressor_release);
-            regroove_effects_set_compressor_makeup(engine->effects_program[i], config.fx_compressor_makeup);
-            regroove_effects_set_phaser_rate(engine->effects_program[i], config.fx_phaser_rate);
-            regroove_effects_set_phaser_depth(engine->effects_program[i], config.fx_phaser_depth);
-            regroove_effects_set_phaser_feedback(engine->effects_program[i], config.fx_phaser_feedback);
-            regroove_effects_set_reverb_room_size(engine->effects_program[i], config.fx_reverb_room_size);
-            regroove_effects_set_reverb_damping(engine->effects_program[i], config.fx_reverb_damping);
-            regroove_effects_set_reverb_mix(engine->effects_program[i], config.fx_reverb_mix);
-            regroove_effects_set_delay_time(engine->effects_program[i], config.fx_delay_time);
-            regroove_effects_set_delay_feedback(engine->effects_program[i], config.fx_delay_feedback);
-            regroove_effects_set_delay_mix(engine->effects_program[i], config.fx_delay_mix);
-        }
-    }
+    // Apply config defaults to effects (per-program chains get them when created)
+    apply_config_effects_defaults(effects_master);
+    engine->effects_program_init = apply_config_effects_defaults;
+    samplecrate_engine_set_load_progress_callback(engine, kit_load_progress, nullptr);
 
     // Note: performance is now created by the engine, accessed via macro
     // Callbacks for pads are set individually per-pad (each with its own context)
@@ -3096,36 +3066,9 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    // Apply mixer and effects settings from RSX if loaded (via engine accessor)
-    if (rsx && rsx->num_programs > 0) {
-        // Apply program volume and pan settings from RSX
-        for (int i = 0; i < rsx->num_programs; i++) {
-            mixer.program_volumes[i] = rsx->program_volumes[i];
-            mixer.program_pans[i] = rsx->program_pans[i];
-            std::cout << "Applied program " << (i + 1) << " settings: volume=" << mixer.program_volumes[i]
-                      << " pan=" << mixer.program_pans[i] << std::endl;
-        }
-
-        // Apply FX chain enable states from RSX
-        mixer.master_fx_enable = rsx->master_fx_enable;
-        for (int i = 0; i < rsx->num_programs; i++) {
-            mixer.program_fx_enable[i] = rsx->program_fx_enable[i];
-        }
-
-        // Apply effects settings from RSX
-        std::cout << "Loading effects settings from RSX..." << std::endl;
-        if (effects_master) {
-            apply_rsx_effects_to_instance(effects_master, &rsx->master_effects);
-            std::cout << "  Master effects loaded from RSX (enabled=" << mixer.master_fx_enable << ")" << std::endl;
-        }
-        for (int i = 0; i < rsx->num_programs; i++) {
-            if (engine->effects_program[i]) {
-                apply_rsx_effects_to_instance(engine->effects_program[i], &rsx->program_effects[i]);
-                std::cout << "  Program " << (i + 1) << " effects loaded from RSX (enabled=" << mixer.program_fx_enable[i] << ")" << std::endl;
-            }
-        }
-        // Note: Note suppression and MIDI pad files are loaded by samplecrate_engine_load_rsx()
-    }
+    // Apply mixer and effects settings from RSX if loaded
+    // Note: Note suppression and MIDI pad files are loaded by samplecrate_engine_load_rsx()
+    samplecrate_engine_apply_rsx_mix(engine);
 
     // Enumerate audio output devices
     num_audio_devices = SDL_GetNumAudioDevices(0);  // 0 = output devices
@@ -3162,6 +3105,15 @@ int main(int argc, char* argv[]) {
         std::cout << "Sample rate: " << obtained.freq << " Hz" << std::endl;
         std::cout << "Channels: " << (int)obtained.channels << std::endl;
         std::cout << "Buffer size: " << obtained.samples << " samples" << std::endl;
+        std::cout << "Effects kernels: " << regroove_effects_get_simd_name() << std::endl;
+
+        // Size the render scratch arena and start render workers before the first callback can run
+        samplecrate_engine_prepare_audio(engine, obtained.samples);
+        samplecrate_engine_set_render_threads(engine, config.render_threads);
+        // Live notes play one buffer after they arrive: constant latency
+        samplecrate_engine_set_live_latency(engine, obtained.samples);
+        // From here on kit loads are swapped in by the audio thread
+        samplecrate_engine_set_audio_running(engine, 1);
         SDL_PauseAudioDevice(current_audio_device_id, 0);  // Start audio
     }
 
@@ -3233,6 +3185,9 @@ int main(int argc, char* argv[]) {
     bool playing = true;
     SDL_Event event;
     while (playing) {
+        // Swap in a kit that finished loading in the background
+        poll_kit_load();
+
         while (SDL_PollEvent(&event)) {
             ImGui_ImplSDL2_ProcessEvent(&event);
             if (event.type == SDL_QUIT) playing = false;
@@ -3330,8 +3285,8 @@ int main(int argc, char* argv[]) {
         // Update step sequencer fade and highlight current position
         // 64 rows map to 16 steps (4 rows per step)
         if (sequencer) {
-            int current_row = medness_sequencer_get_row(sequencer);  // 1-64
-            int current_step = (current_row - 1) / 4;  // 0-15
+            int current_row = medness_sequencer_get_row(sequencer);  // 1-64 (4 bars at 4/4)
+            int current_step = ((current_row - 1) / 4) % 16;  // 0-15, repeating for longer patterns
 
             // Highlight current step
             step_fade[current_step] = 1.0f;
@@ -3391,12 +3346,28 @@ int main(int argc, char* argv[]) {
                 char lcd_text[256] = "";
 
                 // Show error if present
+                int failed_program = samplecrate_engine_get_failed_program(engine);
                 if (!error_message.empty()) {
                     snprintf(lcd_text, sizeof(lcd_text),
                              "ERROR:\n%s",
                              error_message.c_str());
                     lcd_write(lcd_display, lcd_text);
                 }
+                // Show a program that failed to (re)load
+                else if (failed_program >= 0) {
+                    snprintf(lcd_text, sizeof(lcd_text),
+                             "ERROR:\nFailed to load\nProgram %d",
+                             failed_program + 1);
+                    lcd_write(lcd_display, lcd_text);
+                }
+                // Show kit load progress
+                else if (kit_loading) {
+                    const char* name = strrchr(kit_load_path.c_str(), '/');
+                    name = name ? name + 1 : kit_load_path.c_str();
+                    snprintf(lcd_text, sizeof(lcd_text), "Loading:\n%s\n\nPrograms %d/%d",
+                             name, kit_load_loaded.load(), kit_load_total.load());
+                    lcd_write(lcd_display, lcd_text);
+                }
                 // Show file browser when in browse mode (takes priority)
                 else if (file_browser_mode && file_list && file_list->count > 0) {
                     // Display current filename in browser (like Regroove)
@@ -3572,45 +3543,18 @@ int main(int argc, char* argv[]) {
                         // Check if it's an RSX file
                         size_t len = strlen(path);
                         if (len > 4 && (strcmp(path + len - 4, ".rsx") == 0 || strcmp(path + len - 4, ".RSX") == 0)) {
-                            // Load RSX file using engine
+                            // Load RSX file in the background: the current kit keeps
+                            // playing until every program of the new one is ready
                             printf("[File Browser] Loading RSX: %s\n", path);
-
-                            // Stop all MIDI playback before reloading
-                            if (performance) {
-                                medness_performance_stop_all(performance);
-                            }
-                            if (sequence_manager) {
-                                medness_performance_stop_all(sequence_manager);
-                            }
-
-                            // Pause audio device during reload to avoid accessing freed synths
-                            if (current_audio_device_id != 0) {
-                                SDL_PauseAudioDevice(current_audio_device_id, 1);
-                            }
-
-                            // Load the RSX (this can take a while, but audio is paused)
-                            int load_result = samplecrate_engine_load_rsx(engine, path);
-
-                            // Resume audio device
-                            if (current_audio_device_id != 0) {
-                                SDL_PauseAudioDevice(current_audio_device_id, 0);
-                            }
-
-                            if (load_result == 0) {
-                                printf("[File Browser] Successfully loaded: %s\n", path);
-                                rsx_file_path = path;  // Update current file path
-
-                                reload_sequences();  // Load sequences from RSX
-
-                                // Load MIDI files for pads (engine handles routing, provides visual feedback callback)
-                                samplecrate_engine_load_pads(engine, pad_visual_feedback);
-
-                                // Exit browse mode after successful load
-                                file_browser_mode = false;
-
-                                printf("[File Browser] Loaded program 1 from %s\n", file_list->filenames[file_list->current_index]);
-                            } else {
-                                printf("[File Browser] Failed to load: %s\n", path);
+                            if (!kit_loading) {
+                                kit_load_loaded = 0;
+                                kit_load_total = 0;
+                                if (samplecrate_engine_load_rsx_async(engine, path) == 0) {
+                                    kit_loading = true;
+                                    kit_load_path = path;
+                                } else {
+                                    printf("[File Browser] Failed to load: %s\n", path);
+                                }
                             }
                         } else if (len > 4 && (strcmp(path + len - 4, ".sfz") == 0 || strcmp(path + len - 4, ".SFZ") == 0)) {
                             // Direct SFZ file loading (legacy mode)
@@ -4074,12 +4018,20 @@ int main(int argc, char* argv[]) {
                                 strcpy(rsx->program_names[j], rsx->program_names[j + 1]);
                                 rsx->program_volumes[j] = rsx->program_volumes[j + 1];
                                 rsx->program_pans[j] = rsx->program_pans[j + 1];
+                                mixer.program_delay_sends[j] = mixer.program_delay_sends[j + 1];
+                                rsx->program_delay_sends[j] = mixer.program_delay_sends[j];
+                                mixer.program_reverb_sends[j] = mixer.program_reverb_sends[j + 1];
+                                rsx->program_reverb_sends[j] = mixer.program_reverb_sends[j];
                             }
                             // Clear last program
                             rsx->program_files[rsx->num_programs - 1][0] = '\0';
                             rsx->program_names[rsx->num_programs - 1][0] = '\0';
                             rsx->program_volumes[rsx->num_programs - 1] = 1.0f;
                             rsx->program_pans[rsx->num_programs - 1] = 0.5f;
+                            mixer.program_delay_sends[rsx->num_programs - 1] = 0.0f;
+                            rsx->program_delay_sends[rsx->num_programs - 1] = 0.0f;
+                            mixer.program_reverb_sends[rsx->num_programs - 1] = 0.0f;
+                            rsx->program_reverb_sends[rsx->num_programs - 1] = 0.0f;
                             rsx->num_programs--;
 
                             // Autosave
@@ -4366,15 +4318,16 @@ int main(int argc, char* argv[]) {
 
                             // Determine which synth to use based on pad's program setting
                             sfizz_synth_t* target_synth = synth;  // Default to current synth
+                            int target_queue = -1;                 // -1 = current synth
                             if (pad->program >= 0 && pad->program < rsx->num_programs && program_synths[pad->program]) {
                                 target_synth = program_synths[pad->program];
+                                target_queue = pad->program;
                             }
 
-                            std::lock_guard<std::mutex> lock(synth_mutex);
                             if (target_synth) {
                                 // For test button, just send note_on
                                 // The SFZ file's envelope/release settings will control the sound
-                                sfizz_send_note_on(target_synth, 0, pad->note, velocity);
+                                samplecrate_engine_queue_note(engine, target_queue, pad->note, velocity, 1);
 
                                 current_note = pad->note;
                                 current_velocity = velocity;
@@ -4579,12 +4532,8 @@ int main(int argc, char* argv[]) {
                             for (size_t i = 0; i < program_names.size(); i++) {
                                 bool is_selected = (current_selection == (int)i);
                                 if (ImGui::Selectable(program_names[i].c_str(), is_selected)) {
-                                    // Switch to selected program (updates current_program)
-                                    current_program = program_indices[i];
-                                    // Also switch the active synth
-                                    if (current_program >= 0 && current_program < RSX_MAX_PROGRAMS) {
-                                        synth = program_synths[current_program];
-                                    }
+                                    // Switch to selected program (updates current_program and the active synth)
+                                    samplecrate_engine_switch_program(engine, program_indices[i]);
                                 }
                                 if (is_selected) {
                                     ImGui::SetItemDefaultFocus();
@@ -4791,15 +4740,22 @@ int main(int argc, char* argv[]) {
                                         strcpy(rsx->program_names[j], rsx->program_names[j + 1]);
                                         rsx->program_volumes[j] = rsx->program_volumes[j + 1];
                                         rsx->program_pans[j] = rsx->program_pans[j + 1];
+                                        mixer.program_delay_sends[j] = mixer.program_delay_sends[j + 1];
+                                        rsx->program_delay_sends[j] = mixer.program_delay_sends[j];
+                                        mixer.program_reverb_sends[j] = mixer.program_reverb_sends[j + 1];
+                                        rsx->program_reverb_sends[j] = mixer.program_reverb_sends[j];
                                     }
+                                    mixer.program_delay_sends[rsx->num_programs - 1] = 0.0f;
+                                    rsx->program_delay_sends[rsx->num_programs - 1] = 0.0f;
+                                    mixer.program_reverb_sends[rsx->num_programs - 1] = 0.0f;
+                                    rsx->program_reverb_sends[rsx->num_programs - 1] = 0.0f;
                                     rsx->num_programs--;
                                     if (!rsx_file_path.empty()) {
                                         samplecrate_rsx_save(rsx, rsx_file_path.c_str());
                                     }
                                     // Adjust current_program if it was deleted or is now out of range
                                     if (current_program >= rsx->num_programs && rsx->num_programs > 0) {
-                                        current_program = rsx->num_programs - 1;
-                                        synth = program_synths[current_program];
+                                        samplecrate_engine_switch_program(engine, rsx->num_programs - 1);
                                     }
                                     ImGui::CloseCurrentPopup();
                                 }
@@ -4985,10 +4941,29 @@ int main(int argc, char* argv[]) {
                         ImGui::PopItemWidth();
                         ImGui::Dummy(ImVec2(0, 2.0f));
 
+                        // Aux sends into the shared delay/reverb buses (the fader gives up their height)
+                        char send_id[32];
+                        ImGui::PushItemWidth(sliderW);
+                        snprintf(send_id, sizeof(send_id), "##prog%d_dly_send", i);
+                        if (ImGui::SliderFloat(send_id, &mixer.program_delay_sends[i], 0.0f, 1.0f, "DLY")) {
+                            autosave_effects_to_rsx();
+                        }
+                        if (ImGui::IsItemHovered()) ImGui::SetTooltip("Delay send %.2f", mixer.program_delay_sends[i]);
+                        ImGui::Dummy(ImVec2(0, 2.0f));
+                        snprintf(send_id, sizeof(send_id), "##prog%d_rev_send", i);
+                        if (ImGui::SliderFloat(send_id, &mixer.program_reverb_sends[i], 0.0f, 1.0f, "REV")) {
+                            autosave_effects_to_rsx();
+                        }
+                        if (ImGui::IsItemHovered()) ImGui::SetTooltip("Reverb send %.2f", mixer.program_reverb_sends[i]);
+                        ImGui::PopItemWidth();
+                        ImGui::Dummy(ImVec2(0, 2.0f));
+
                         // Volume fader
+                        float prog_sliderH = sliderH - 2.0f * (panSliderH + 2.0f);
+                        if (prog_sliderH < MIN_SLIDER_HEIGHT) prog_sliderH = MIN_SLIDER_HEIGHT;
                         char slider_id[32];
                         snprintf(slider_id, sizeof(slider_id), "##prog%d_vol", i);
-                        if (ImGui::VSliderFloat(slider_id, ImVec2(sliderW, sliderH), &mixer.program_volumes[i], 0.0f, 1.0f, "")) {
+                        if (ImGui::VSliderFloat(slider_id, ImVec2(sliderW, prog_sliderH), &mixer.program_volumes[i], 0.0f, 1.0f, "")) {
                             // Sync to RSX and autosave
                             if (rsx) {
                                 rsx->program_volumes[i] = mixer.program_volumes[i];
@@ -5910,14 +5885,13 @@ int main(int argc, char* argv[]) {
                                     target_synth = program_synths[target_prog];
                                 }
 
-                                std::lock_guard<std::mutex> lock(synth_mutex);
                                 if (target_synth) {
-                                    sfizz_send_note_on(target_synth, 0, pad->note, velocity);
+                                    samplecrate_engine_queue_note(engine, actual_program, pad->note, velocity, 1);
 
                                     // Track which pad/note is held for note_off on release
                                     held_pad_index = pad_idx;
                                     held_pad_note = pad->note;
-                                    held_pad_synth = target_synth;
+                                    held_pad_program = actual_program;
 
                                     current_note = pad->note;
                                     current_velocity = velocity;
@@ -5936,13 +5910,12 @@ int main(int argc, char* argv[]) {
                             }
                         } else if (!is_active && was_held) {
                             // Button just released - send note_off
-                            std::lock_guard<std::mutex> lock(synth_mutex);
-                            if (held_pad_synth && held_pad_note >= 0) {
-                                sfizz_send_note_off(held_pad_synth, 0, held_pad_note, 0);
+                            if (held_pad_program >= 0 && held_pad_note >= 0) {
+                                samplecrate_engine_queue_note(engine, held_pad_program, held_pad_note, 0, 0);
                             }
                             held_pad_index = -1;
                             held_pad_note = -1;
-                            held_pad_synth = nullptr;
+                            held_pad_program = -1;
                         } else if (is_active && !pad_configured && !learn_mode_active) {
                             // Clicked on unconfigured pad - do nothing
                         } else if (is_active && learn_mode_active) {
@@ -6149,6 +6122,7 @@ int main(int argc, char* argv[]) {
                         for (const auto& pp : playing_pads) {
                             std::map<int, std::vector<int>> emap;
                             for (int i = 0; i < pp.event_count; i++) {
+                                if (pp.events[i].type != MEDNESS_TRACK_EVENT_NOTE) continue;
                                 // Convert MIDI tick to pattern row (0-63)
                                 int row = (pp.events[i].tick * 4) / pp.tpqn;
                                 if (row >= 0 && row < 64) {
@@ -6300,6 +6274,72 @@ int main(int argc, char* argv[]) {
                             medness_performance_set_start_mode(sequence_manager, (SequenceStartMode)mode_idx);
                         }
 
+                        // Swing (applied by the sequencer at playback time, slots
+                        // without their own swing; saved to the RSX)
+                        if (sequencer) {
+                            ImGui::SameLine();
+                            ImGui::Text("  Swing:");
+                            ImGui::SameLine();
+                            float swing_pct = 50.0f + rsx->swing * 25.0f;
+                            ImGui::SetNextItemWidth(150.0f);
+                            if (ImGui::SliderFloat("##swing", &swing_pct, 50.0f, 75.0f, "%.0f%%")) {
+                                rsx->swing = (swing_pct - 50.0f) / 25.0f;
+                                medness_sequencer_set_swing(sequencer, rsx->swing);
+                            }
+                            if (ImGui::IsItemDeactivatedAfterEdit() && !rsx_file_path.empty()) {
+                                samplecrate_rsx_save(rsx, rsx_file_path.c_str());
+                            }
+                        }
+
+                        // Meter and pattern length (kit settings, saved to the RSX)
+                        if (sequencer) {
+                            bool meter_changed = false;
+                            ImGui::SameLine();
+                            ImGui::Text("  Meter:");
+                            ImGui::SameLine();
+                            int beats = rsx->beats_per_bar;
+                            ImGui::SetNextItemWidth(80.0f);
+                            if (ImGui::InputInt("##meter_beats", &beats)) {
+                                if (beats < 1) beats = 1;
+                                if (beats > 16) beats = 16;
+                                meter_changed = (beats != rsx->beats_per_bar);
+                                rsx->beats_per_bar = beats;
+                            }
+                            ImGui::SameLine();
+                            ImGui::Text("/");
+                            ImGui::SameLine();
+                            const int unit_values[] = { 2, 4, 8, 16 };
+                            const char* unit_names[] = { "2", "4", "8", "16" };
+                            int unit_idx = 1;
+                            for (int k = 0; k < 4; k++) {
+                                if (unit_values[k] == rsx->beat_unit) unit_idx = k;
+                            }
+                            ImGui::SetNextItemWidth(50.0f);
+                            if (ImGui::Combo("##meter_unit", &unit_idx, unit_names, 4)) {
+                                meter_changed = (unit_values[unit_idx] != rsx->beat_unit);
+                                rsx->beat_unit = unit_values[unit_idx];
+                            }
+                            ImGui::SameLine();
+                            ImGui::Text("  Bars:");
+                            ImGui::SameLine();
+                            int bars = rsx->pattern_bars;
+                            ImGui::SetNextItemWidth(80.0f);
+                            if (ImGui::InputInt("##pattern_bars", &bars)) {
+                                if (bars < 1) bars = 1;
+                                if (bars > 16) bars = 16;
+                                meter_changed = (bars != rsx->pattern_bars);
+                                rsx->pattern_bars = bars;
+                            }
+
+                            if (meter_changed) {
+                                medness_sequencer_set_time_signature(sequencer, rsx->beats_per_bar, rsx->beat_unit);
+                                medness_sequencer_set_pattern_bars(sequencer, rsx->pattern_bars);
+                                if (!rsx_file_path.empty()) {
+                                    samplecrate_rsx_save(rsx, rsx_file_path.c_str());
+                                }
+                            }
+                        }
+
                         ImGui::Spacing();
                         ImGui::Separator();
                         ImGui::Spacing();
@@ -6383,6 +6423,88 @@ int main(int argc, char* argv[]) {
                                 }
                             }
 
+                            // MIDI output routing: internal synths or a channel on the MIDI output
+                            ImGui::Text("  MIDI out: ");
+                            ImGui::SameLine();
+                            ImGui::SetNextItemWidth(120.0f);
+                            int out_channel = seq_def->midi_output_channel;
+                            char out_label[16];
+                            if (out_channel >= 0) {
+                                snprintf(out_label, sizeof(out_label), "Ch %d", out_channel + 1);
+                            } else {
+                                snprintf(out_label, sizeof(out_label), "Internal");
+                            }
+                            if (ImGui::BeginCombo("##midi_out", out_label)) {
+                                int new_channel = out_channel;
+                                if (ImGui::Selectable("Internal", out_channel < 0)) new_channel = -1;
+                                for (int ch = 0; ch < 16; ch++) {
+                                    char ch_label[16];
+                                    snprintf(ch_label, sizeof(ch_label), "Ch %d", ch + 1);
+                                    if (ImGui::Selectable(ch_label, out_channel == ch)) new_channel = ch;
+                                }
+                                ImGui::EndCombo();
+
+                                if (new_channel != out_channel) {
+                                    seq_def->midi_output_channel = new_channel;
+                                    MednessSequence* player = medness_performance_get_player(sequence_manager, i);
+                                    if (player) medness_sequence_set_midi_output(player, new_channel);
+                                    if (!rsx_file_path.empty()) {
+                                        samplecrate_rsx_save(rsx, rsx_file_path.c_str());
+                                    }
+                                }
+                            }
+
+                            // Phrase loop length in rows (0 = each phrase loops at its own length)
+                            ImGui::SameLine();
+                            ImGui::Text("  Loop rows:");
+                            ImGui::SameLine();
+                            ImGui::SetNextItemWidth(100.0f);
+                            int loop_rows = seq_def->loop_length;
+                            if (ImGui::InputInt("##loop_rows", &loop_rows, 4, 16)) {
+                                if (loop_rows < 0) loop_rows = 0;
+                                if (loop_rows > 1024) loop_rows = 1024;
+                                seq_def->loop_length = loop_rows;
+                                MednessSequence* player = medness_performance_get_player(sequence_manager, i);
+                                if (player) medness_sequence_set_loop_length(player, loop_rows);
+                                if (!rsx_file_path.empty()) {
+                                    samplecrate_rsx_save(rsx, rsx_file_path.c_str());
+                                }
+                            }
+                            if (ImGui::IsItemHovered()) {
+                                ImGui::SetTooltip("Loop length in rows (16th notes), 0 = phrase length");
+                            }
+
+                            // Swing of its own, or the kit swing
+                            ImGui::SameLine();
+                            bool own_swing = (seq_def->swing >= 0.0f);
+                            if (ImGui::Checkbox("Swing##seq_swing_on", &own_swing)) {
+                                seq_def->swing = own_swing ? rsx->swing : -1.0f;
+                                MednessSequence* player = medness_performance_get_player(sequence_manager, i);
+                                if (player) medness_sequence_set_swing(player, seq_def->swing);
+                                if (!rsx_file_path.empty()) {
+                                    samplecrate_rsx_save(rsx, rsx_file_path.c_str());
+                                }
+                            }
+                            ImGui::SameLine();
+                            if (own_swing) {
+                                float seq_swing_pct = 50.0f + seq_def->swing * 25.0f;
+                                ImGui::SetNextItemWidth(120.0f);
+                                if (ImGui::SliderFloat("##seq_swing", &seq_swing_pct, 50.0f, 75.0f, "%.0f%%")) {
+                                    seq_def->swing = (seq_swing_pct - 50.0f) / 25.0f;
+                                    MednessSequence* player = medness_performance_get_player(sequence_manager, i);
+                                    if (player) medness_sequence_set_swing(player, seq_def->swing);
+                                }
+                                if (ImGui::IsItemDeactivatedAfterEdit() && !rsx_file_path.empty()) {
+                                    samplecrate_rsx_save(rsx, rsx_file_path.c_str());
+                                }
+                            } else {
+                                ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "Kit");
+                            }
+                            if (seq_def->groove.steps > 0) {
+                                ImGui::SameLine();
+                                ImGui::TextColored(ImVec4(0.5f, 0.8f, 0.5f, 1.0f), "Groove %d", seq_def->groove.steps);
+                            }
+
                             // Show which pads are assigned to this sequence
                             ImGui::Text("  Assigned pads: ");
                             ImGui::SameLine();
@@ -6927,6 +7049,32 @@ int main(int argc, char* argv[]) {
                 ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
                     "When enabled, sync playback position to external MIDI clock");
 
+                ImGui::Spacing();
+
+                // MIDI Clock Send (master mode)
+                bool midi_clock_send = (config.midi_clock_send == 1);
+                if (ImGui::Checkbox("Send MIDI Clock and SPP (master)", &midi_clock_send)) {
+                    config.midi_clock_send = midi_clock_send ? 1 : 0;
+                    samplecrate_config_save(&config, "samplecrate.ini");
+                }
+                ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
+                    "Sends clock, start/stop and SPP on the MIDI output (paused while receiving clock)");
+
+                ImGui::Spacing();
+
+                // Clock lock status (from the clock recovery PLL)
+                if (midi_clock.active) {
+                    bool locked = midi_clock_pll_is_locked(&midi_clock.pll);
+                    ImGui::TextColored(locked ? ImVec4(0.4f, 1.0f, 0.4f, 1.0f) : ImVec4(1.0f, 0.8f, 0.3f, 1.0f),
+                        "Clock: %s  %.2f BPM  jitter %.2f ms  phase %+.2f pulses",
+                        locked ? "LOCKED" : "acquiring", midi_clock.bpm,
+                        midi_clock_pll_get_jitter_us(&midi_clock.pll) / 1000.0f, midi_clock.phase_error);
+                    ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
+                        "Lost pulses: %u  Resyncs: %u", midi_clock.pll.missed, midi_clock.pll.resyncs);
+                } else {
+                    ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Clock: no MIDI clock received");
+                }
+
                 ImGui::Spacing();
                 ImGui::Separator();
                 ImGui::Spacing();
@@ -7304,9 +7452,23 @@ int main(int argc, char* argv[]) {
                 }
                 ImGui::PopItemWidth();
 
+                ImGui::Spacing();
+
+                // Render threads (parallel program rendering)
+                ImGui::Text("Render Threads:");
+                ImGui::PushItemWidth(200.0f);
+                int render_threads = config.render_threads < 1 ? 1 : config.render_threads;
+                if (ImGui::SliderInt("##render_threads", &render_threads, 1, 16)) {
+                    config.render_threads = render_threads;
+                    samplecrate_config_save(&config, "samplecrate.ini");
+                }
+                ImGui::PopItemWidth();
+                ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
+                    "Programs render in parallel on this many cores (1 = audio thread only)");
+
                 ImGui::Spacing();
                 ImGui::TextColored(ImVec4(0.9f, 0.7f, 0.2f, 1.0f),
-                    "Audio device changes require application restart to take effect");
+                    "Audio device and render thread changes require application restart to take effect");
             }
         }
         ImGui::EndChild();
@@ -7392,6 +7554,7 @@ int main(int argc, char* argv[]) {
     // Close audio before destroying synth to avoid race conditions
     if (current_audio_device_id != 0) {
         SDL_CloseAudioDevice(current_audio_device_id);
+        samplecrate_engine_set_audio_running(engine, 0);
     }
 
     // Safely destroy synths
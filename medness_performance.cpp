@@ -6,12 +6,6 @@
 #include <libgen.h>
 #include <iostream>
 
-// Context for MIDI callbacks - includes sequence index and program number
-struct SequenceMIDIContext {
-    int seq_index;   // Sequence index (for mute/solo checking)
-    int program;     // Target program number
-};
-
 // Queued sequence info
 typedef struct {
     int active;           // Is this queue entry active?
@@ -199,6 +193,11 @@ int medness_performance_load_from_rsx(MednessPerformance* manager,
         // Configure sequence
         medness_sequence_set_tempo(seq, manager->tempo_bpm);
         medness_sequence_set_loop(seq, seq_def->loop);
+        medness_sequence_set_midi_output(seq, seq_def->midi_output_channel);
+        medness_sequence_set_loop_length(seq, seq_def->loop_length);
+        medness_sequence_set_swing(seq, seq_def->swing);
+        MednessGroove groove;
+        medness_sequence_set_groove(seq, medness_performance_groove_from_rsx(&seq_def->groove, &groove));
 
         // Store sequence's program number and setup context
         manager->sequence_programs[i] = seq_def->program_number;
@@ -294,6 +293,11 @@ int medness_performance_reload_sequence(MednessPerformance* manager,
     // Configure sequence
     medness_sequence_set_tempo(seq, manager->tempo_bpm);
     medness_sequence_set_loop(seq, seq_def->loop);
+    medness_sequence_set_midi_output(seq, seq_def->midi_output_channel);
+    medness_sequence_set_loop_length(seq, seq_def->loop_length);
+    medness_sequence_set_swing(seq, seq_def->swing);
+    MednessGroove groove;
+    medness_sequence_set_groove(seq, medness_performance_groove_from_rsx(&seq_def->groove, &groove));
 
     // Store sequence's program number
     manager->sequence_programs[seq_index] = seq_def->program_number;
@@ -790,3 +794,16 @@ int medness_performance_is_audible(MednessPerformance* manager, int seq_index) {
     // SOLO logic is already handled by set_solo() which sets mute states
     return manager->sequence_muted[seq_index] ? 0 : 1;
 }
+
+// Convert an RSX groove template for the sequencer
+const MednessGroove* medness_performance_groove_from_rsx(const RSXGroove* groove, MednessGroove* out) {
+    if (!groove || !out || groove->steps <= 0) return nullptr;
+
+    memset(out, 0, sizeof(MednessGroove));
+    out->steps = (groove->steps < MEDNESS_GROOVE_MAX_STEPS) ? groove->steps : MEDNESS_GROOVE_MAX_STEPS;
+    for (int i = 0; i < out->steps; i++) {
+        out->timing[i] = groove->timing[i];
+        out->velocity[i] = groove->velocity[i];
+    }
+    return out;
+}
@@ -77,6 +77,12 @@ SequenceStartMode medness_performance_get_start_mode(MednessPerformance* manager
 // Set tempo for all sequences
 void medness_performance_set_tempo(MednessPerformance* manager, float bpm);
 
+// Userdata passed with every sequence event to the MIDI callback
+typedef struct {
+    int seq_index;   // Sequence index (for mute/solo checking)
+    int program;     // Target program number, or -1 for the current program
+} SequenceMIDIContext;
+
 // Set MIDI event callback for all sequences
 void medness_performance_set_midi_callback(MednessPerformance* manager,
                                              MednessSequenceEventCallback callback,
@@ -139,6 +145,10 @@ void medness_performance_set_solo(MednessPerformance* manager, int seq_index, in
 // Returns: 1 if audible, 0 if should be silent
 int medness_performance_is_audible(MednessPerformance* manager, int seq_index);
 
+// Convert an RSX groove template for the sequencer into 'out'
+// Returns: out, or NULL if the template has no steps
+const MednessGroove* medness_performance_groove_from_rsx(const RSXGroove* groove, MednessGroove* out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,9 @@ struct MednessSequence {
     bool playing;
     bool sequence_loop;          // Loop entire sequence
     float tempo_bpm;
+    int midi_output_channel;     // MIDI output channel (-1 = internal synths)
+    int loop_length_rows;        // Phrase loop length in rows (0 = phrase length)
+    float swing;                 // Swing amount (-1 = the sequencer's)
 
     MednessSequenceEventCallback callback;
     void* userdata;
@@ -35,8 +38,11 @@ struct MednessSequence {
 #define SEQUENCE_SLOT_BASE 32
 #define MAX_SEQUENCES 16
 
+// 24 PPQN: a row (16th note) is 6 pulses
+#define SEQUENCE_PULSES_PER_ROW 6
+
 // Internal callback from MednessSequencer for MIDI events
-static void sequence_midi_callback(int note, int velocity, int on, void* userdata) {
+static void sequence_midi_callback(int note, int velocity, int on, int frame_offset, void* userdata) {
     MednessSequence* seq = (MednessSequence*)userdata;
     if (!seq) {
         std::cout << "[CALLBACK] ERROR: seq is NULL!" << std::endl;
@@ -56,10 +62,24 @@ static void sequence_midi_callback(int note, int velocity, int on, void* userdat
     }
 
     // Pass through to user callback
-    seq->callback(note, velocity, on, seq->userdata);
+    seq->callback(note, velocity, on, frame_offset, seq->userdata);
+}
+
+static void sequence_loop_callback(void* userdata);
+
+// Put a phrase track into our sequencer slot. The slot loop callback is
+// cleared with the previous track, so register it again each time.
+static void sequence_attach_track(MednessSequence* seq, MednessTrack* track) {
+    medness_sequencer_set_slot_midi_output(seq->sequencer, seq->sequencer_slot, seq->midi_output_channel);
+    medness_sequencer_set_slot_loop_length(seq->sequencer, seq->sequencer_slot,
+                                           seq->loop_length_rows * SEQUENCE_PULSES_PER_ROW);
+    medness_sequencer_add_track(seq->sequencer, seq->sequencer_slot, track,
+                                sequence_midi_callback, seq);
+    medness_sequencer_set_slot_loop_callback(seq->sequencer, seq->sequencer_slot,
+                                             sequence_loop_callback, seq);
 }
 
-// Internal callback from MednessSequencer when track loops
+// Internal callback from MednessSequencer when our slot's track loops
 static void sequence_loop_callback(void* userdata) {
     MednessSequence* seq = (MednessSequence*)userdata;
     if (!seq) return;
@@ -122,9 +142,7 @@ static void sequence_loop_callback(void* userdata) {
 
                 // Add the new phrase track to sequencer
                 if (next_phrase.track) {
-                    medness_sequencer_add_track(seq->sequencer, seq->sequencer_slot,
-                                               next_phrase.track,
-                                               sequence_midi_callback, seq);
+                    sequence_attach_track(seq, next_phrase.track);
                 }
 
                 // Fire phrase change callback
@@ -152,6 +170,9 @@ MednessSequence* medness_sequence_create(void) {
     seq->playing = false;
     seq->sequence_loop = true;  // Default: loop sequence
     seq->tempo_bpm = 125.0f;
+    seq->midi_output_channel = -1;
+    seq->loop_length_rows = 0;
+    seq->swing = -1.0f;
     seq->callback = nullptr;
     seq->userdata = nullptr;
     seq->phrase_change_callback = nullptr;
@@ -282,13 +303,9 @@ void medness_sequence_play(MednessSequence* player) {
         std::cout << prefix << " Track has " << event_count << " events" << std::endl;
         std::cout << prefix << " Adding track to sequencer (internal slot=" << player->sequencer_slot << ")" << std::endl;
 
-        // Add track to sequencer with loop callback
-        medness_sequencer_add_track(player->sequencer, player->sequencer_slot,
-                                   first_phrase.track,
-                                   sequence_midi_callback, player);
-
-        // Set the loop callback to handle phrase transitions
-        medness_sequencer_set_loop_callback(player->sequencer, sequence_loop_callback, player);
+        // Add track to sequencer with its slot loop callback (handles phrase
+        // transitions at this track's own loop boundary)
+        sequence_attach_track(player, first_phrase.track);
 
         // Fire phrase change callback
         if (player->phrase_change_callback) {
@@ -364,6 +381,63 @@ int medness_sequence_get_loop(MednessSequence* player) {
     return player->sequence_loop ? 1 : 0;
 }
 
+// Set MIDI output routing
+void medness_sequence_set_midi_output(MednessSequence* player, int channel) {
+    if (!player) return;
+    player->midi_output_channel = (channel >= 0 && channel <= 15) ? channel : -1;
+
+    // Applies to the slot right away if we're playing
+    if (player->playing && player->sequencer) {
+        medness_sequencer_set_slot_midi_output(player->sequencer, player->sequencer_slot,
+                                               player->midi_output_channel);
+    }
+}
+
+// Get MIDI output routing
+int medness_sequence_get_midi_output(MednessSequence* player) {
+    if (!player) return -1;
+    return player->midi_output_channel;
+}
+
+// Set phrase loop length
+void medness_sequence_set_loop_length(MednessSequence* player, int rows) {
+    if (!player) return;
+    player->loop_length_rows = (rows > 0) ? rows : 0;
+
+    // Applies to the current phrase right away if we're playing
+    if (player->playing && player->sequencer) {
+        medness_sequencer_set_slot_loop_length(player->sequencer, player->sequencer_slot,
+                                               player->loop_length_rows * SEQUENCE_PULSES_PER_ROW);
+    }
+}
+
+// Get phrase loop length
+int medness_sequence_get_loop_length(MednessSequence* player) {
+    if (!player) return 0;
+    return player->loop_length_rows;
+}
+
+// Set swing (the slot keeps it across phrases, so it's set once here)
+void medness_sequence_set_swing(MednessSequence* player, float amount) {
+    if (!player) return;
+    player->swing = (amount >= 0.0f) ? amount : -1.0f;
+    if (player->sequencer && player->sequencer_slot >= 0) {
+        medness_sequencer_set_slot_swing(player->sequencer, player->sequencer_slot, player->swing);
+    }
+}
+
+// Get swing
+float medness_sequence_get_swing(MednessSequence* player) {
+    if (!player) return -1.0f;
+    return player->swing;
+}
+
+// Set groove template
+void medness_sequence_set_groove(MednessSequence* player, const MednessGroove* groove) {
+    if (!player || !player->sequencer || player->sequencer_slot < 0) return;
+    medness_sequencer_set_slot_groove(player->sequencer, player->sequencer_slot, groove);
+}
+
 // These update functions are no longer needed - sequencer handles timing!
 void medness_sequence_update(MednessSequence* player, float delta_ms, int current_beat) {
     // No-op: MednessSequencer handles all timing
@@ -393,9 +467,7 @@ int medness_sequence_jump_to_phrase(MednessSequence* player, int phrase_index) {
     if (player->playing) {
         Phrase& new_phrase = player->phrases[phrase_index];
         if (new_phrase.track) {
-            medness_sequencer_add_track(player->sequencer, player->sequencer_slot,
-                                       new_phrase.track,
-                                       sequence_midi_callback, player);
+            sequence_attach_track(player, new_phrase.track);
         }
     }
 
@@ -1,6 +1,8 @@
 #ifndef MEDNESS_SEQUENCE_H
 #define MEDNESS_SEQUENCE_H
 
+#include "medness_sequencer.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -9,8 +11,9 @@ extern "C" {
 typedef struct MednessSequence MednessSequence;
 
 // Callback type for MIDI sequence events
-// Parameters: note, velocity, on (1=note_on, 0=note_off), userdata
-typedef void (*MednessSequenceEventCallback)(int note, int velocity, int on, void* userdata);
+// Parameters: note, velocity, on (1=note_on, 0=note_off),
+// frame_offset (frame within the current audio block), userdata
+typedef void (*MednessSequenceEventCallback)(int note, int velocity, int on, int frame_offset, void* userdata);
 
 // Callback type for phrase change events
 // Parameters: phrase_index, phrase_name, userdata
@@ -78,6 +81,26 @@ void medness_sequence_set_loop(MednessSequence* player, int loop);
 // Get sequence looping mode
 int medness_sequence_get_loop(MednessSequence* player);
 
+// Route the sequence to the MIDI output on 'channel' (0-15) instead of the
+// internal synths, or -1 for the internal synths (default)
+void medness_sequence_set_midi_output(MednessSequence* player, int channel);
+int medness_sequence_get_midi_output(MednessSequence* player);
+
+// Set the loop length in rows (16th notes) for every phrase of the sequence,
+// or 0 to loop each phrase at its own length rounded up to whole bars (default)
+void medness_sequence_set_loop_length(MednessSequence* player, int rows);
+int medness_sequence_get_loop_length(MednessSequence* player);
+
+// Swing and groove apply to the sequence's sequencer slot right away (call
+// after medness_sequence_set_sequencer, not from the audio thread)
+
+// Set the sequence's swing (0.0-1.0), or -1 to follow the global swing (default)
+void medness_sequence_set_swing(MednessSequence* player, float amount);
+float medness_sequence_get_swing(MednessSequence* player);
+
+// Set the sequence's groove template (copied), or NULL to follow the global one (default)
+void medness_sequence_set_groove(MednessSequence* player, const MednessGroove* groove);
+
 // Update playback (call regularly from main loop)
 // delta_ms: time elapsed since last update in milliseconds
 // current_beat: current MIDI clock beat number (for quantization, -1 if no MIDI clock)
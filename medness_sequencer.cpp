@@ -2,45 +2,410 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#include <math.h>
 #include <iostream>
 
-// Pattern is 64 rows = 64 sixteenths = 4 bars at 4/4
+// Default pattern is 4 bars at 4/4 = 64 rows (sixteenths)
 // At 24 PPQN: 64 sixteenths * 6 pulses/sixteenth = 384 pulses
-#define PATTERN_LENGTH_PULSES 384
-#define PATTERN_LENGTH_ROWS 64
+#define DEFAULT_PATTERN_BARS 4
+#define DEFAULT_BEATS_PER_BAR 4
+#define DEFAULT_BEAT_UNIT 4
+#define PULSES_PER_ROW 6
 // Slot layout for programmable drum/beat computer:
 // - Slots 0-15: Uploaded sequences (SysEx remote control)
 // - Slots 16-31: Pads (local trigger pads)
 #define MAX_TRACK_SLOTS 32
 
-// Forward declaration
-static void medness_sequencer_play_tracks(MednessSequencer* sequencer, int old_pulse, int new_pulse);
-
 // Track slot - holds reference to track and playback state
+// Swing and groove of the sequencer or of one slot
+typedef struct {
+    float swing;                        // Swing amount (-1 on a slot = use the sequencer's)
+    MednessGroove groove;               // Groove template (if has_groove)
+    int has_groove;
+} MednessSequencerFeel;
+
 struct MednessSequencerTrackSlot {
     MednessTrack* track;                // Reference to track (not owned)
     SequencerMidiCallback midi_callback; // MIDI event callback
     void* userdata;                     // User context
-    int last_tick_processed;            // Last tick fired (to prevent duplicates)
+    int next_event;                     // Cursor: next event to fire (events are pulse-sorted)
     int active;                         // Is this slot active?
+    double loop_start;                  // Song position where the slot's current loop pass began
+    double loop_length;                 // Loop length in pulses (always > 0)
+    int loop_length_override;           // Explicit loop length in pulses (0 = derive from track)
+    SequencerLoopCallback loop_callback; // Fired when this slot's loop wraps (optional)
+    void* loop_userdata;
+    int midi_output_channel;            // Route events to the MIDI output on this channel (-1 = midi_callback, audio thread)
+    uint64_t held_notes[2];             // Notes left on through midi_callback (bit per note, atomic)
+    MednessSequencerFeel feel;          // Swing and groove (the sequencer's where not set)
 };
 
 struct MednessSequencer {
     float bpm;                      // Current tempo in BPM
-    int pulse_count;                // Current pulse within pattern (0-383)
+    int pulse_count;                // Current pulse within pattern (0 to pattern_length_pulses-1)
+    double pattern_start;           // Song position where the current pattern pass began
     int active;                     // Is sequencer active?
     int external_clock;             // Is external MIDI clock driving? (1=yes, 0=no)
 
+    // Time signature and global pattern length
+    int beats_per_bar;
+    int beat_unit;
+    int pattern_bars;
+    int pattern_length_pulses;
+
     SequencerLoopCallback loop_callback;
     void* loop_userdata;
 
+    // Receives events of slots routed to the MIDI output
+    SequencerMidiOutputCallback midi_output_callback;
+    void* midi_output_userdata;
+
+    // Global swing and groove (slots may override)
+    MednessSequencerFeel feel;
+
     // Track slots (one per pad)
     MednessSequencerTrackSlot slots[MAX_TRACK_SLOTS];
 
-    // For internal timing advancement
-    float accumulated_pulses;
+    // Transport: an absolute sample counter. The song position (pulses since
+    // song start, never wrapped) is derived from the last tempo anchor rather
+    // than accumulated block by block, so it cannot drift.
+    int64_t sample_position;        // Frames advanced since creation
+    int64_t anchor_sample;          // sample_position at the last tempo/position change
+    double anchor_pulse;            // Song position at anchor_sample
+    int sample_rate;
+    double song_pulse;              // Song position played up to
+
+    // Inputs from other threads, applied by the audio thread at block start
+    float pending_bpm;              // Tempo to switch to (set_bpm)
+    int64_t pending_phase;          // Phase correction in 1/PHASE_SCALE pulses (adjust_phase)
+    uint64_t pending_meter;         // Time signature and pattern bars (METER_PACK)
+    int pending_loop_length[MAX_TRACK_SLOTS]; // Slot loop length overrides (set_slot_loop_length)
+    uint32_t pending_loop_dirty;    // Slots whose override changed (one bit per slot, MAX_TRACK_SLOTS <= 32)
+    int pending_midi_output[MAX_TRACK_SLOTS]; // Slot MIDI output channels (set_slot_midi_output)
+    uint32_t pending_output_dirty;  // Slots whose channel changed (one bit per slot)
+    int pending_spp;                // Song position (16ths) to jump to (set_spp, -1 = none)
+    // Swing and groove per slot plus the global one (index GLOBAL_FEEL), each
+    // behind a seqlock counter that is odd while a setter writes it
+    MednessSequencerFeel pending_feel[MAX_TRACK_SLOTS + 1];
+    uint32_t pending_feel_sequence[MAX_TRACK_SLOTS + 1];
+    uint64_t pending_feel_dirty;    // Entries changed since the audio thread took them (one bit each)
+    uint64_t block_host_us;         // Host time of the next block (set_block_time, 0 = unknown)
+
+    // Last block start, published for get_position_at() on other threads
+    uint32_t stamp_sequence;        // Odd while being written
+    int stamp_valid;
+    uint64_t stamp_host_us;
+    double stamp_song_pulse;
+    double stamp_pulses_per_frame;
 };
 
+// Fixed-point scale of pending phase corrections (micro-pulses)
+#define PHASE_SCALE 1000000.0
+
+// Time signature and pattern length packed into one word, so a change is
+// handed to the audio thread in a single atomic store
+#define METER_PACK(beats_per_bar, beat_unit, bars) \
+    (((uint64_t)(beats_per_bar) << 32) | ((uint64_t)(beat_unit) << 16) | (uint64_t)(bars))
+#define METER_BEATS(meter) ((int)((meter) >> 32))
+#define METER_UNIT(meter) ((int)(((meter) >> 16) & 0xFFFF))
+#define METER_BARS(meter) ((int)((meter) & 0xFFFF))
+#define METER_MAX_VALUE 0xFFFF
+
+// pending_feel entry of the sequencer's own swing and groove
+#define GLOBAL_FEEL MAX_TRACK_SLOTS
+
+static void medness_sequencer_apply_meter(MednessSequencer* sequencer, uint64_t meter);
+static void medness_sequencer_apply_spp(MednessSequencer* sequencer, int spp_position);
+static void medness_sequencer_update_slot_length(MednessSequencer* sequencer, MednessSequencerTrackSlot* slot);
+static int medness_sequencer_read_feel(MednessSequencer* sequencer, int index, MednessSequencerFeel* out, int wait);
+
+// Song position at an absolute sample, from the current tempo anchor
+static double medness_sequencer_song_pulse_at(MednessSequencer* sequencer, int64_t sample) {
+    double pulses_per_frame = (sequencer->bpm * 24.0) / (60.0 * (double)sequencer->sample_rate);
+    return sequencer->anchor_pulse + (double)(sample - sequencer->anchor_sample) * pulses_per_frame;
+}
+
+// Start a new tempo anchor: the song is at 'song_pulse' at the current sample
+static void medness_sequencer_set_anchor(MednessSequencer* sequencer, double song_pulse) {
+    sequencer->anchor_sample = sequencer->sample_position;
+    sequencer->anchor_pulse = song_pulse;
+    sequencer->song_pulse = song_pulse;
+    // A phase correction can land just before the pattern start
+    double position = song_pulse - sequencer->pattern_start;
+    sequencer->pulse_count = (position > 0.0) ? (int)position : 0;
+}
+
+static void medness_sequencer_output_notes_off(MednessSequencer* sequencer, MednessSequencerTrackSlot* slot);
+
+// Apply tempo, phase, meter, loop length, MIDI output, song position, swing
+// and groove changes requested from other threads (audio thread)
+static void medness_sequencer_apply_pending(MednessSequencer* sequencer) {
+    float bpm;
+    __atomic_load(&sequencer->pending_bpm, &bpm, __ATOMIC_ACQUIRE);
+    int64_t phase = __atomic_exchange_n(&sequencer->pending_phase, 0, __ATOMIC_ACQ_REL);
+
+    if (bpm != sequencer->bpm || phase != 0) {
+        // Anchor at the current position so the new tempo applies from here on
+        medness_sequencer_set_anchor(sequencer, sequencer->song_pulse + (double)phase / PHASE_SCALE);
+        sequencer->bpm = bpm;
+    }
+
+    uint64_t meter = __atomic_load_n(&sequencer->pending_meter, __ATOMIC_ACQUIRE);
+    if (meter != METER_PACK(sequencer->beats_per_bar, sequencer->beat_unit, sequencer->pattern_bars)) {
+        medness_sequencer_apply_meter(sequencer, meter);
+    }
+
+    uint32_t dirty = __atomic_exchange_n(&sequencer->pending_loop_dirty, 0, __ATOMIC_ACQ_REL);
+    for (int i = 0; dirty != 0 && i < MAX_TRACK_SLOTS; i++, dirty >>= 1) {
+        if (!(dirty & 1)) continue;
+        MednessSequencerTrackSlot* slot = &sequencer->slots[i];
+        slot->loop_length_override = __atomic_load_n(&sequencer->pending_loop_length[i], __ATOMIC_ACQUIRE);
+        medness_sequencer_update_slot_length(sequencer, slot);
+    }
+
+    // Rerouted here, between blocks, so no note starts on the old route after
+    // its notes were ended
+    dirty = __atomic_exchange_n(&sequencer->pending_output_dirty, 0, __ATOMIC_ACQ_REL);
+    for (int i = 0; dirty != 0 && i < MAX_TRACK_SLOTS; i++, dirty >>= 1) {
+        if (!(dirty & 1)) continue;
+        MednessSequencerTrackSlot* slot = &sequencer->slots[i];
+        int channel = __atomic_load_n(&sequencer->pending_midi_output[i], __ATOMIC_ACQUIRE);
+        if (channel == slot->midi_output_channel) continue;
+
+        // Notes already started on the old route would never get their note offs
+        medness_sequencer_output_notes_off(sequencer, slot);
+        slot->midi_output_channel = channel;
+    }
+
+    // After the meter and loop lengths, which the jump lines the loops up with
+    int spp = __atomic_exchange_n(&sequencer->pending_spp, -1, __ATOMIC_ACQ_REL);
+    if (spp >= 0) {
+        medness_sequencer_apply_spp(sequencer, spp);
+    }
+
+    uint64_t feel_dirty = __atomic_exchange_n(&sequencer->pending_feel_dirty, 0, __ATOMIC_ACQ_REL);
+    for (int i = 0; feel_dirty != 0 && i <= GLOBAL_FEEL; i++, feel_dirty >>= 1) {
+        if (!(feel_dirty & 1)) continue;
+        MednessSequencerFeel feel;
+        if (!medness_sequencer_read_feel(sequencer, i, &feel, 0)) {
+            // A setter is writing it right now: take it next block
+            __atomic_fetch_or(&sequencer->pending_feel_dirty, (uint64_t)1 << i, __ATOMIC_RELEASE);
+            continue;
+        }
+        if (i == GLOBAL_FEEL) {
+            sequencer->feel = feel;
+        } else {
+            sequencer->slots[i].feel = feel;
+        }
+    }
+}
+
+// Publish the block start for get_position_at() (seqlock: readers retry
+// while the counter is odd or changed under them)
+static void medness_sequencer_publish_stamp(MednessSequencer* sequencer, int valid,
+                                            double song_pulse, double pulses_per_frame) {
+    uint32_t seq = sequencer->stamp_sequence;
+    __atomic_store_n(&sequencer->stamp_sequence, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    sequencer->stamp_valid = valid && sequencer->block_host_us != 0;
+    sequencer->stamp_host_us = sequencer->block_host_us;
+    sequencer->stamp_song_pulse = song_pulse;
+    sequencer->stamp_pulses_per_frame = pulses_per_frame;
+    __atomic_store_n(&sequencer->stamp_sequence, seq + 2, __ATOMIC_RELEASE);
+}
+
+// Move a slot's read cursor so the next event played is the first one at or
+// after 'pulse' (binary search over the track's events, which are sorted by
+// tick and therefore by pulse)
+static void medness_sequencer_seek_slot(MednessSequencerTrackSlot* slot, double pulse) {
+    slot->next_event = 0;
+
+    int event_count = 0;
+    const MednessTrackEvent* events = slot->track ? medness_track_get_events(slot->track, &event_count) : NULL;
+    if (!events) return;
+
+    int lo = 0;
+    int hi = event_count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (events[mid].pulse < pulse) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    slot->next_event = lo;
+}
+
+// Pulses in one bar of the current time signature (a quarter note is 24 pulses)
+static int medness_sequencer_bar_pulses(MednessSequencer* sequencer) {
+    return sequencer->beats_per_bar * 96 / sequencer->beat_unit;
+}
+
+// Recompute a slot's loop length: the explicit override if set, otherwise the
+// track length rounded up to whole bars. Keeps the slot's phase within the new
+// loop and moves the cursor there.
+static void medness_sequencer_update_slot_length(MednessSequencer* sequencer, MednessSequencerTrackSlot* slot) {
+    double length = (double)sequencer->pattern_length_pulses;
+
+    if (slot->loop_length_override > 0) {
+        length = (double)slot->loop_length_override;
+    } else if (slot->track) {
+        double bar = (double)medness_sequencer_bar_pulses(sequencer);
+        double track_pulses = medness_track_tick_to_pulse(slot->track, medness_track_get_length_ticks(slot->track));
+        // Small tolerance so rounding in the tempo map doesn't add an extra bar
+        int bars = (int)ceil(track_pulses / bar - 1e-6);
+        if (bars < 1) bars = 1;
+        length = bars * bar;
+    }
+
+    double position = fmod(sequencer->song_pulse - slot->loop_start, length);
+    if (position < 0.0) position += length;
+
+    slot->loop_length = length;
+    slot->loop_start = sequencer->song_pulse - position;
+    medness_sequencer_seek_slot(slot, position);
+}
+
+// Internal: Where an event at slot position 'pulse' plays once swing and the
+// groove template are applied, and its velocity offset. Constant time, so
+// firing stays O(events fired).
+static double medness_sequencer_groove_pulse(const MednessSequencer* sequencer, const MednessSequencerTrackSlot* slot,
+                                             double pulse, int* velocity_offset) {
+    *velocity_offset = 0;
+
+    float swing = (slot->feel.swing >= 0.0f) ? slot->feel.swing : sequencer->feel.swing;
+    const MednessGroove* groove = slot->feel.has_groove ? &slot->feel.groove :
+                                  (sequencer->feel.has_groove ? &sequencer->feel.groove : NULL);
+    if (swing <= 0.0f && !groove) return pulse;
+
+    double played = pulse;
+
+    // Swing: warp time within each 8th note so its second 16th starts later
+    // (events between 16ths move proportionally, the 8th grid stays put)
+    if (swing > 0.0f) {
+        double eighth = 2.0 * PULSES_PER_ROW;
+        double base = floor(pulse / eighth) * eighth;
+        double x = pulse - base;
+        double split = PULSES_PER_ROW * (1.0 + 0.5 * swing);
+        if (x < PULSES_PER_ROW) {
+            played = base + x * split / PULSES_PER_ROW;
+        } else {
+            played = base + split + (x - PULSES_PER_ROW) * (eighth - split) / PULSES_PER_ROW;
+        }
+    }
+
+    // Groove template: offsets of the nearest 16th
+    if (groove) {
+        int row = (int)floor(pulse / PULSES_PER_ROW + 0.5);
+        int step = row % groove->steps;
+        played += groove->timing[step] * PULSES_PER_ROW;
+        *velocity_offset = groove->velocity[step];
+    }
+
+    return played;
+}
+
+// Internal: Fire a slot's events from its cursor up to end_pulse (inclusive if
+// 'inclusive', else exclusive), at their grooved positions. With 'flush' (end
+// of a loop pass) every event before end_pulse fires, including ones the
+// groove moved past it. origin_pulse is the slot position at frame 0 of the
+// block, pulses_per_frame the tempo (0 = fire at offset 0).
+static void medness_sequencer_fire_slot(MednessSequencer* sequencer, MednessSequencerTrackSlot* slot,
+                                        double end_pulse, int inclusive, int flush,
+                                        double origin_pulse, double pulses_per_frame, int num_samples) {
+    // Get events from track
+    int event_count = 0;
+    const MednessTrackEvent* events = medness_track_get_events(slot->track, &event_count);
+    if (!events) return;
+
+    // Fire events from the cursor up to end_pulse (events are sorted, so
+    // only the events actually played are visited)
+    if (slot->next_event > event_count) slot->next_event = event_count;
+    while (slot->next_event < event_count) {
+        const MednessTrackEvent* evt = &events[slot->next_event];
+        int velocity_offset = 0;
+        double play_pulse = medness_sequencer_groove_pulse(sequencer, slot, evt->pulse, &velocity_offset);
+        if (flush) {
+            if (evt->pulse >= end_pulse) break;
+        } else if (inclusive ? play_pulse > end_pulse : play_pulse >= end_pulse) {
+            break;
+        }
+        slot->next_event++;
+
+        int velocity = evt->velocity;
+        if (evt->type == MEDNESS_TRACK_EVENT_NOTE && evt->on && velocity_offset != 0) {
+            velocity += velocity_offset;
+            if (velocity < 1) velocity = 1;
+            if (velocity > 127) velocity = 127;
+        }
+
+        // Frame within this block where the event falls
+        int frame_offset = 0;
+        if (pulses_per_frame > 0.0 && num_samples > 0) {
+            double frames = (play_pulse - origin_pulse) / pulses_per_frame;
+            frame_offset = (int)(frames + 0.5);
+            if (frame_offset < 0) frame_offset = 0;
+            if (frame_offset > num_samples - 1) frame_offset = num_samples - 1;
+        }
+
+        // Fire MIDI event: to the MIDI output if the slot is routed there,
+        // else notes to the slot's callback (it only plays notes)
+        if (slot->midi_output_channel >= 0) {
+            if (sequencer->midi_output_callback) {
+                MednessTrackEvent played = *evt;
+                played.velocity = velocity;
+                sequencer->midi_output_callback(&played, slot->midi_output_channel, frame_offset,
+                                                sequencer->midi_output_userdata);
+            }
+        } else if (slot->midi_callback && evt->type == MEDNESS_TRACK_EVENT_NOTE) {
+            slot->midi_callback(evt->note, velocity, evt->on, frame_offset, slot->userdata);
+            uint64_t bit = (uint64_t)1 << (evt->note & 63);
+            if (evt->on && velocity > 0) {
+                __atomic_fetch_or(&slot->held_notes[(evt->note >> 6) & 1], bit, __ATOMIC_RELAXED);
+            } else {
+                __atomic_fetch_and(&slot->held_notes[(evt->note >> 6) & 1], ~bit, __ATOMIC_RELAXED);
+            }
+        }
+    }
+}
+
+// Internal: Play every active slot up to song position 'target', firing the
+// events passed and wrapping each slot at its own loop length. Events exactly
+// at the target fire now if 'inclusive' (clock pulses), otherwise with the next
+// call (audio blocks, so an event on a block boundary lands at frame 0 of the
+// next block). block_start is the song position at frame 0 of the block.
+static void medness_sequencer_advance_slots(MednessSequencer* sequencer, double target, int inclusive,
+                                            double block_start, double pulses_per_frame, int num_samples) {
+    for (int i = 0; i < MAX_TRACK_SLOTS; i++) {
+        MednessSequencerTrackSlot* slot = &sequencer->slots[i];
+        if (!slot->active) continue;
+
+        // Fire the rest of the loop (up to, not including, its end), then wrap
+        while (target >= slot->loop_start + slot->loop_length) {
+            medness_sequencer_fire_slot(sequencer, slot, slot->loop_length, 0, 1, block_start - slot->loop_start,
+                                        pulses_per_frame, num_samples);
+            slot->loop_start += slot->loop_length;
+            medness_sequencer_seek_slot(slot, 0.0);
+
+            // Slot loop callback (may swap or remove this slot's track, e.g. phrase advance)
+            if (slot->loop_callback) {
+                double loop_point = slot->loop_start;
+                slot->loop_callback(slot->loop_userdata);
+                if (!slot->active) break;
+
+                // A track added by the callback starts at the loop point
+                slot->loop_start = loop_point;
+                medness_sequencer_seek_slot(slot, 0.0);
+            }
+        }
+        if (!slot->active) continue;
+
+        medness_sequencer_fire_slot(sequencer, slot, target - slot->loop_start, inclusive, 0, block_start - slot->loop_start,
+                                    pulses_per_frame, num_samples);
+    }
+}
+
 MednessSequencer* medness_sequencer_create(void) {
     MednessSequencer* sequencer = new MednessSequencer();
 
@@ -50,15 +415,57 @@ MednessSequencer* medness_sequencer_create(void) {
     sequencer->external_clock = 0;  // Default to internal clock
     sequencer->loop_callback = NULL;
     sequencer->loop_userdata = NULL;
-    sequencer->accumulated_pulses = 0.0f;
+    sequencer->midi_output_callback = NULL;
+    sequencer->midi_output_userdata = NULL;
+    sequencer->feel.swing = 0.0f;
+    sequencer->feel.has_groove = 0;
+    sequencer->pending_feel[GLOBAL_FEEL] = sequencer->feel;
+    sequencer->pending_feel_sequence[GLOBAL_FEEL] = 0;
+    sequencer->pending_feel_dirty = 0;
+    sequencer->pattern_start = 0.0;
+    sequencer->sample_position = 0;
+    sequencer->anchor_sample = 0;
+    sequencer->anchor_pulse = 0.0;
+    sequencer->sample_rate = 44100;
+    sequencer->song_pulse = 0.0;
+    sequencer->pending_bpm = sequencer->bpm;
+    sequencer->pending_phase = 0;
+    sequencer->pending_loop_dirty = 0;
+    sequencer->pending_output_dirty = 0;
+    sequencer->pending_spp = -1;
+    sequencer->block_host_us = 0;
+    sequencer->stamp_sequence = 0;
+    sequencer->stamp_valid = 0;
+    sequencer->stamp_host_us = 0;
+    sequencer->stamp_song_pulse = 0.0;
+    sequencer->stamp_pulses_per_frame = 0.0;
+    sequencer->beats_per_bar = DEFAULT_BEATS_PER_BAR;
+    sequencer->beat_unit = DEFAULT_BEAT_UNIT;
+    sequencer->pattern_bars = DEFAULT_PATTERN_BARS;
+    sequencer->pattern_length_pulses = DEFAULT_PATTERN_BARS * medness_sequencer_bar_pulses(sequencer);
+    sequencer->pending_meter = METER_PACK(DEFAULT_BEATS_PER_BAR, DEFAULT_BEAT_UNIT, DEFAULT_PATTERN_BARS);
 
     // Initialize all slots as inactive
     for (int i = 0; i < MAX_TRACK_SLOTS; i++) {
         sequencer->slots[i].track = NULL;
         sequencer->slots[i].midi_callback = NULL;
         sequencer->slots[i].userdata = NULL;
-        sequencer->slots[i].last_tick_processed = -1;
+        sequencer->slots[i].next_event = 0;
         sequencer->slots[i].active = 0;
+        sequencer->slots[i].loop_start = 0.0;
+        sequencer->slots[i].loop_length = sequencer->pattern_length_pulses;
+        sequencer->slots[i].loop_length_override = 0;
+        sequencer->pending_loop_length[i] = 0;
+        sequencer->slots[i].loop_callback = NULL;
+        sequencer->slots[i].loop_userdata = NULL;
+        sequencer->slots[i].midi_output_channel = -1;
+        sequencer->pending_midi_output[i] = -1;
+        sequencer->slots[i].held_notes[0] = 0;
+        sequencer->slots[i].held_notes[1] = 0;
+        sequencer->slots[i].feel.swing = -1.0f;
+        sequencer->slots[i].feel.has_groove = 0;
+        sequencer->pending_feel[i] = sequencer->slots[i].feel;
+        sequencer->pending_feel_sequence[i] = 0;
     }
 
     return sequencer;
@@ -72,36 +479,88 @@ void medness_sequencer_destroy(MednessSequencer* sequencer) {
 
 void medness_sequencer_set_bpm(MednessSequencer* sequencer, float bpm) {
     if (!sequencer || bpm <= 0.0f) return;
-    sequencer->bpm = bpm;
+    // Taken over by the audio thread at the next block
+    __atomic_store(&sequencer->pending_bpm, &bpm, __ATOMIC_RELEASE);
 }
 
 float medness_sequencer_get_bpm(MednessSequencer* sequencer) {
     if (!sequencer) return 125.0f;
-    return sequencer->bpm;
+    float bpm;
+    __atomic_load(&sequencer->pending_bpm, &bpm, __ATOMIC_ACQUIRE);
+    return bpm;
+}
+
+void medness_sequencer_adjust_phase(MednessSequencer* sequencer, double pulses) {
+    if (!sequencer) return;
+    __atomic_fetch_add(&sequencer->pending_phase, (int64_t)(pulses * PHASE_SCALE), __ATOMIC_ACQ_REL);
+}
+
+void medness_sequencer_set_block_time(MednessSequencer* sequencer, uint64_t host_time_us) {
+    if (!sequencer) return;
+    sequencer->block_host_us = host_time_us;
+}
+
+int medness_sequencer_get_position_at(MednessSequencer* sequencer, uint64_t host_time_us, double* out_song_pulse) {
+    if (!sequencer || !out_song_pulse) return -1;
+
+    for (int attempt = 0; attempt < 8; attempt++) {
+        uint32_t seq = __atomic_load_n(&sequencer->stamp_sequence, __ATOMIC_ACQUIRE);
+        if (seq & 1) continue;
+
+        int valid = sequencer->stamp_valid;
+        uint64_t stamp_host_us = sequencer->stamp_host_us;
+        double song_pulse = sequencer->stamp_song_pulse;
+        double pulses_per_frame = sequencer->stamp_pulses_per_frame;
+        int sample_rate = sequencer->sample_rate;
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&sequencer->stamp_sequence, __ATOMIC_RELAXED) != seq) continue;
+
+        if (!valid) return -1;
+        double frames = ((double)host_time_us - (double)stamp_host_us) * 1e-6 * sample_rate;
+        *out_song_pulse = song_pulse + frames * pulses_per_frame;
+        return 0;
+    }
+    return -1;
 }
 
 void medness_sequencer_set_spp(MednessSequencer* sequencer, int spp_position) {
     if (!sequencer) return;
+    __atomic_store_n(&sequencer->pending_spp, (spp_position < 0) ? 0 : spp_position, __ATOMIC_RELEASE);
+}
 
-    // SPP is in 16th notes - convert to pulse within pattern
-    int spp_within_pattern = spp_position % PATTERN_LENGTH_ROWS;
-    sequencer->pulse_count = spp_within_pattern * 6;  // 6 pulses per 16th note
+// Jump to an SPP position (audio thread)
+static void medness_sequencer_apply_spp(MednessSequencer* sequencer, int spp_position) {
+    // SPP is in 16th notes (6 pulses each) counted from song start; every
+    // loop (the pattern and each slot) is assumed to have started there
+    double song_pulse = (double)spp_position * PULSES_PER_ROW;
+    sequencer->pattern_start = song_pulse - fmod(song_pulse, (double)sequencer->pattern_length_pulses);
+    medness_sequencer_set_anchor(sequencer, song_pulse);
 
-    // Update all active tracks' last_tick_processed to prevent retriggering
-    // When SPP jumps position, we don't want to fire events that may have already played
-    const int TPQN = 480;
-    int new_tick = (sequencer->pulse_count * TPQN) / 24;
+    // Move every active slot to its phase of the song position so events that
+    // may have already played aren't retriggered
     for (int i = 0; i < MAX_TRACK_SLOTS; i++) {
-        if (sequencer->slots[i].active) {
-            sequencer->slots[i].last_tick_processed = new_tick - 1;
+        MednessSequencerTrackSlot* slot = &sequencer->slots[i];
+        if (slot->active) {
+            double position = fmod(song_pulse, slot->loop_length);
+            slot->loop_start = song_pulse - position;
+            medness_sequencer_seek_slot(slot, position);
         }
     }
 }
 
 int medness_sequencer_update(MednessSequencer* sequencer, int num_samples, int sample_rate) {
     if (!sequencer || !sequencer->active) return -1;
+
+    medness_sequencer_apply_pending(sequencer);
     if (num_samples <= 0 || sample_rate <= 0) return sequencer->pulse_count;
 
+    // A new sample rate changes the pulses per frame: re-anchor like a tempo change
+    if (sample_rate != sequencer->sample_rate) {
+        medness_sequencer_set_anchor(sequencer, sequencer->song_pulse);
+        sequencer->sample_rate = sample_rate;
+    }
+
     // Check if any tracks are playing - only advance if we have active tracks
     bool has_active_tracks = false;
     for (int i = 0; i < MAX_TRACK_SLOTS; i++) {
@@ -114,60 +573,52 @@ int medness_sequencer_update(MednessSequencer* sequencer, int num_samples, int s
     // If no tracks playing: reset position to 0 (unless externally synced to SPP)
     // This ensures next trigger starts from the beginning
     if (!has_active_tracks) {
+        sequencer->sample_position += num_samples;
+
         // TODO: Check if we're synced to external SPP - if so, keep position
         // For now: always reset to 0 when nothing is playing
-        if (sequencer->pulse_count != 0) {
+        if (sequencer->song_pulse != 0.0) {
             printf("[SEQUENCER] No active tracks - resetting position to 0\n");
-            sequencer->pulse_count = 0;
-            sequencer->accumulated_pulses = 0.0f;
         }
+        sequencer->pattern_start = 0.0;
+        medness_sequencer_set_anchor(sequencer, 0.0);
+        medness_sequencer_publish_stamp(sequencer, 0, 0.0, 0.0);
         return -1;  // Return -1 to indicate sequencer is not running
     }
 
-    int old_pulse = sequencer->pulse_count;
-
     // Always advance position using internal clock
     // External MIDI clock only adjusts the BPM, doesn't control position directly
     // (external_clock flag is deprecated - sequencer always runs on internal timebase)
-    {
-        // Calculate how many pulses elapsed based on sample count
-        double seconds_elapsed = (double)num_samples / (double)sample_rate;
-        double pulses_per_second = (sequencer->bpm * 24.0) / 60.0;
-        double exact_pulses = seconds_elapsed * pulses_per_second;
-
-        sequencer->accumulated_pulses += (float)exact_pulses;
-
-        int pulse_increment = (int)sequencer->accumulated_pulses;
-        if (pulse_increment > 0) {
-            sequencer->pulse_count += pulse_increment;
-            sequencer->accumulated_pulses -= pulse_increment;
-
-            // Check for pattern wrap
-            if (sequencer->pulse_count >= PATTERN_LENGTH_PULSES) {
-                sequencer->pulse_count = sequencer->pulse_count % PATTERN_LENGTH_PULSES;
-
-                // On wrap, update track positions to match new pulse position
-                // This prevents double-firing when position jumps
-                const int TPQN = 480;
-                int new_tick = (sequencer->pulse_count * TPQN) / 24;
-                for (int i = 0; i < MAX_TRACK_SLOTS; i++) {
-                    if (sequencer->slots[i].active) {
-                        sequencer->slots[i].last_tick_processed = new_tick - 1;
-                    }
-                }
+    double pulses_per_frame = (sequencer->bpm * 24.0) / (60.0 * (double)sample_rate);
+
+    // Exact song positions at the first frame of this block and the first frame after it
+    int64_t block_end_sample = sequencer->sample_position + num_samples;
+    double block_start = sequencer->song_pulse;
+    double block_end = medness_sequencer_song_pulse_at(sequencer, block_end_sample);
+    medness_sequencer_publish_stamp(sequencer, 1, block_start, pulses_per_frame);
+
+    while (block_end >= sequencer->pattern_start + sequencer->pattern_length_pulses) {
+        // Play the slots up to the pattern end, each event at its own frame
+        double wrap = sequencer->pattern_start + sequencer->pattern_length_pulses;
+        medness_sequencer_advance_slots(sequencer, wrap, 0, block_start, pulses_per_frame, num_samples);
+
+        // Wrap, then continue in the new pattern within the same block
+        sequencer->pattern_start = wrap;
+        sequencer->song_pulse = wrap;
+        sequencer->pulse_count = 0;
 
-                // Fire loop callback
-                if (sequencer->loop_callback) {
-                    sequencer->loop_callback(sequencer->loop_userdata);
-                }
-            }
+        // Fire loop callback (may swap slot tracks, e.g. phrase advance)
+        if (sequencer->loop_callback) {
+            sequencer->loop_callback(sequencer->loop_userdata);
         }
-
-        // Play all active tracks at current position
-        medness_sequencer_play_tracks(sequencer, old_pulse, sequencer->pulse_count);
     }
-    // If external clock mode: position is already updated by medness_sequencer_clock_pulse()
-    // We don't need to fire events here - they're fired in clock_pulse()
+
+    // Play all active slots up to the end of this block, with frame offsets
+    medness_sequencer_advance_slots(sequencer, block_end, 0, block_start, pulses_per_frame, num_samples);
+
+    sequencer->sample_position = block_end_sample;
+    sequencer->song_pulse = block_end;
+    sequencer->pulse_count = (int)(block_end - sequencer->pattern_start);
 
     return sequencer->pulse_count;
 }
@@ -175,36 +626,36 @@ int medness_sequencer_update(MednessSequencer* sequencer, int num_samples, int s
 void medness_sequencer_clock_pulse(MednessSequencer* sequencer) {
     if (!sequencer || !sequencer->active) return;
 
-    int old_pulse = sequencer->pulse_count;
-    sequencer->pulse_count++;
+    medness_sequencer_apply_pending(sequencer);
+
+    double target = sequencer->song_pulse + 1.0;
+    double wrap = sequencer->pattern_start + sequencer->pattern_length_pulses;
 
     // Check for pattern wrap
-    if (sequencer->pulse_count >= PATTERN_LENGTH_PULSES) {
+    if (target >= wrap) {
+        // Play the slots up to the wrap without firing the new pattern's
+        // first pulse yet: the loop callback may swap tracks first
+        medness_sequencer_advance_slots(sequencer, wrap, 0, wrap, 0.0, 0);
+        sequencer->pattern_start = wrap;
+        sequencer->song_pulse = wrap;
         sequencer->pulse_count = 0;
 
-        // On wrap, update track positions to match new pulse position
-        // This prevents double-firing when position jumps
-        const int TPQN = 480;
-        int new_tick = (sequencer->pulse_count * TPQN) / 24;
-        for (int i = 0; i < MAX_TRACK_SLOTS; i++) {
-            if (sequencer->slots[i].active) {
-                sequencer->slots[i].last_tick_processed = new_tick - 1;
-            }
-        }
-
         // Fire loop callback
         if (sequencer->loop_callback) {
             sequencer->loop_callback(sequencer->loop_userdata);
         }
     }
 
-    // Play all active tracks at current position
-    medness_sequencer_play_tracks(sequencer, old_pulse, sequencer->pulse_count);
+    // Play all active tracks at current position (no sub-block timing for clock pulses)
+    medness_sequencer_advance_slots(sequencer, target, 1, target, 0.0, 0);
+
+    // The clock moved the song position: the internal clock continues from here
+    medness_sequencer_set_anchor(sequencer, target);
 }
 
 int medness_sequencer_get_row(MednessSequencer* sequencer) {
     if (!sequencer) return 1;
-    return (sequencer->pulse_count / 6) + 1;
+    return (sequencer->pulse_count / PULSES_PER_ROW) + 1;
 }
 
 int medness_sequencer_get_pulse(MednessSequencer* sequencer) {
@@ -212,6 +663,78 @@ int medness_sequencer_get_pulse(MednessSequencer* sequencer) {
     return sequencer->pulse_count;
 }
 
+double medness_sequencer_get_song_position(MednessSequencer* sequencer) {
+    if (!sequencer) return 0.0;
+    return sequencer->song_pulse;
+}
+
+int64_t medness_sequencer_get_sample_position(MednessSequencer* sequencer) {
+    if (!sequencer) return 0;
+    return sequencer->sample_position;
+}
+
+// Internal: Switch to a new time signature / pattern length (audio thread)
+static void medness_sequencer_apply_meter(MednessSequencer* sequencer, uint64_t meter) {
+    sequencer->beats_per_bar = METER_BEATS(meter);
+    sequencer->beat_unit = METER_UNIT(meter);
+    sequencer->pattern_bars = METER_BARS(meter);
+    sequencer->pattern_length_pulses = sequencer->pattern_bars * medness_sequencer_bar_pulses(sequencer);
+    double position = sequencer->song_pulse - sequencer->pattern_start;
+    if (position >= sequencer->pattern_length_pulses) {
+        sequencer->pattern_start = sequencer->song_pulse - fmod(position, (double)sequencer->pattern_length_pulses);
+    }
+    sequencer->pulse_count = (int)(sequencer->song_pulse - sequencer->pattern_start);
+
+    // Derived slot lengths are whole bars, so they follow the time signature
+    for (int i = 0; i < MAX_TRACK_SLOTS; i++) {
+        medness_sequencer_update_slot_length(sequencer, &sequencer->slots[i]);
+    }
+}
+
+void medness_sequencer_set_time_signature(MednessSequencer* sequencer, int beats_per_bar, int beat_unit) {
+    if (!sequencer || beats_per_bar <= 0 || beats_per_bar > METER_MAX_VALUE) return;
+    // Beat unit must divide a whole note (96 pulses) evenly
+    if (beat_unit <= 0 || beat_unit > 32 || (beat_unit & (beat_unit - 1)) != 0) return;
+
+    // Keep the pending pattern bars (set_pattern_bars may race with us)
+    uint64_t meter = __atomic_load_n(&sequencer->pending_meter, __ATOMIC_ACQUIRE);
+    while (!__atomic_compare_exchange_n(&sequencer->pending_meter, &meter,
+                                        METER_PACK(beats_per_bar, beat_unit, METER_BARS(meter)),
+                                        1, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+    }
+}
+
+void medness_sequencer_get_time_signature(MednessSequencer* sequencer, int* beats_per_bar, int* beat_unit) {
+    uint64_t meter = sequencer ? __atomic_load_n(&sequencer->pending_meter, __ATOMIC_ACQUIRE) :
+                                 METER_PACK(DEFAULT_BEATS_PER_BAR, DEFAULT_BEAT_UNIT, DEFAULT_PATTERN_BARS);
+    if (beats_per_bar) *beats_per_bar = METER_BEATS(meter);
+    if (beat_unit) *beat_unit = METER_UNIT(meter);
+}
+
+void medness_sequencer_set_pattern_bars(MednessSequencer* sequencer, int bars) {
+    if (!sequencer || bars <= 0 || bars > METER_MAX_VALUE) return;
+
+    uint64_t meter = __atomic_load_n(&sequencer->pending_meter, __ATOMIC_ACQUIRE);
+    while (!__atomic_compare_exchange_n(&sequencer->pending_meter, &meter,
+                                        METER_PACK(METER_BEATS(meter), METER_UNIT(meter), bars),
+                                        1, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+    }
+}
+
+int medness_sequencer_get_pattern_bars(MednessSequencer* sequencer) {
+    if (!sequencer) return DEFAULT_PATTERN_BARS;
+    return METER_BARS(__atomic_load_n(&sequencer->pending_meter, __ATOMIC_ACQUIRE));
+}
+
+int medness_sequencer_get_pattern_length(MednessSequencer* sequencer) {
+    if (!sequencer) return DEFAULT_PATTERN_BARS * 96;
+    return sequencer->pattern_length_pulses;
+}
+
+int medness_sequencer_get_pattern_rows(MednessSequencer* sequencer) {
+    return medness_sequencer_get_pattern_length(sequencer) / PULSES_PER_ROW;
+}
+
 void medness_sequencer_set_loop_callback(MednessSequencer* sequencer, SequencerLoopCallback callback, void* userdata) {
     if (!sequencer) return;
     sequencer->loop_callback = callback;
@@ -243,23 +766,53 @@ void medness_sequencer_add_track(MednessSequencer* sequencer, int slot, MednessT
     sequencer->slots[slot].midi_callback = midi_callback;
     sequencer->slots[slot].userdata = userdata;
 
-    // Initialize last_tick_processed to current position to prevent double-firing
-    // Convert current pulse to tick
-    const int TPQN = 480;
-    int current_tick = (sequencer->pulse_count * TPQN) / 24;
-    sequencer->slots[slot].last_tick_processed = current_tick - 1;
+    // Start at the current pattern position (wrapped into the slot's own
+    // loop); seeking there prevents double-firing
+    sequencer->slots[slot].loop_start = sequencer->pattern_start;
+    medness_sequencer_update_slot_length(sequencer, &sequencer->slots[slot]);
 
     sequencer->slots[slot].active = (track != NULL) ? 1 : 0;
 }
 
+// Internal: End the notes a slot left on, on its current route (their note
+// offs won't be played): note offs through the slot's callback for notes it
+// played there, All Notes Off on a routed slot's channel
+static void medness_sequencer_output_notes_off(MednessSequencer* sequencer, MednessSequencerTrackSlot* slot) {
+    if (slot->midi_output_channel < 0) {
+        for (int word = 0; word < 2; word++) {
+            uint64_t held = __atomic_exchange_n(&slot->held_notes[word], 0, __ATOMIC_RELAXED);
+            for (int bit = 0; held != 0 && bit < 64; bit++, held >>= 1) {
+                if ((held & 1) && slot->midi_callback) {
+                    slot->midi_callback(word * 64 + bit, 0, 0, 0, slot->userdata);
+                }
+            }
+        }
+        return;
+    }
+    if (!slot->active || !sequencer->midi_output_callback) return;
+
+    MednessTrackEvent evt;
+    memset(&evt, 0, sizeof(evt));
+    evt.type = MEDNESS_TRACK_EVENT_CONTROL;
+    evt.note = 123;  // All Notes Off
+    evt.channel = slot->midi_output_channel;
+    sequencer->midi_output_callback(&evt, slot->midi_output_channel, 0, sequencer->midi_output_userdata);
+}
+
 void medness_sequencer_remove_track(MednessSequencer* sequencer, int slot) {
     if (!sequencer || slot < 0 || slot >= MAX_TRACK_SLOTS) return;
 
+    medness_sequencer_output_notes_off(sequencer, &sequencer->slots[slot]);
+
     sequencer->slots[slot].track = NULL;
     sequencer->slots[slot].midi_callback = NULL;
     sequencer->slots[slot].userdata = NULL;
-    sequencer->slots[slot].last_tick_processed = -1;
+    sequencer->slots[slot].next_event = 0;
     sequencer->slots[slot].active = 0;
+    sequencer->slots[slot].loop_start = 0.0;
+    sequencer->slots[slot].loop_length = sequencer->pattern_length_pulses;
+    sequencer->slots[slot].loop_callback = NULL;
+    sequencer->slots[slot].loop_userdata = NULL;
 }
 
 int medness_sequencer_slot_is_active(MednessSequencer* sequencer, int slot) {
@@ -267,41 +820,172 @@ int medness_sequencer_slot_is_active(MednessSequencer* sequencer, int slot) {
     return sequencer->slots[slot].active;
 }
 
-// Internal: Play all tracks from old_pulse to new_pulse
-static void medness_sequencer_play_tracks(MednessSequencer* sequencer, int old_pulse, int new_pulse) {
-    if (!sequencer) return;
+void medness_sequencer_set_slot_loop_length(MednessSequencer* sequencer, int slot, int length_pulses) {
+    if (!sequencer || slot < 0 || slot >= MAX_TRACK_SLOTS) return;
+
+    // Taken over by the audio thread at the next block (called again with the
+    // same length, e.g. on every phrase change, this does nothing)
+    int length = (length_pulses > 0) ? length_pulses : 0;
+    if (__atomic_load_n(&sequencer->pending_loop_length[slot], __ATOMIC_ACQUIRE) == length) return;
+    __atomic_store_n(&sequencer->pending_loop_length[slot], length, __ATOMIC_RELEASE);
+    __atomic_fetch_or(&sequencer->pending_loop_dirty, 1u << slot, __ATOMIC_ACQ_REL);
+}
 
-    // Convert pulses to ticks (assumes all tracks use same TPQN)
-    // For now, use a fixed TPQN of 480 (will get from track later)
-    const int TPQN = 480;
+int medness_sequencer_get_slot_loop_length(MednessSequencer* sequencer, int slot) {
+    if (!sequencer || slot < 0 || slot >= MAX_TRACK_SLOTS) return 0;
+    return (int)sequencer->slots[slot].loop_length;
+}
 
-    // Calculate ticks from pulses: tick = (pulse / 24) * TPQN
-    int old_tick = (old_pulse * TPQN) / 24;
-    int new_tick = (new_pulse * TPQN) / 24;
+void medness_sequencer_set_slot_loop_callback(MednessSequencer* sequencer, int slot,
+                                              SequencerLoopCallback callback, void* userdata) {
+    if (!sequencer || slot < 0 || slot >= MAX_TRACK_SLOTS) return;
+    sequencer->slots[slot].loop_callback = callback;
+    sequencer->slots[slot].loop_userdata = userdata;
+}
 
-    // Iterate through all active slots
-    for (int i = 0; i < MAX_TRACK_SLOTS; i++) {
-        if (!sequencer->slots[i].active) continue;
+// Groove
+//
+// Setters write a staged copy (pending_feel) under its seqlock and the audio
+// thread copies it into the live one at block start, so fire_slot never sees
+// a half-written template. Setters spin on each other, never on the audio
+// thread.
+
+// Internal: Copy a staged feel. Returns 0 if a setter was writing it (with
+// 'wait' set, retries until it gets a consistent copy instead).
+static int medness_sequencer_read_feel(MednessSequencer* sequencer, int index, MednessSequencerFeel* out, int wait) {
+    for (;;) {
+        uint32_t seq = __atomic_load_n(&sequencer->pending_feel_sequence[index], __ATOMIC_ACQUIRE);
+        if (!(seq & 1)) {
+            *out = sequencer->pending_feel[index];
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&sequencer->pending_feel_sequence[index], __ATOMIC_RELAXED) == seq) return 1;
+        }
+        if (!wait) return 0;
+    }
+}
 
-        MednessSequencerTrackSlot* slot = &sequencer->slots[i];
+// Internal: Lock a staged feel for writing (waits for other setters)
+static MednessSequencerFeel* medness_sequencer_begin_feel(MednessSequencer* sequencer, int index) {
+    uint32_t seq = __atomic_load_n(&sequencer->pending_feel_sequence[index], __ATOMIC_RELAXED);
+    for (;;) {
+        if (!(seq & 1) && __atomic_compare_exchange_n(&sequencer->pending_feel_sequence[index], &seq, seq + 1,
+                                                      1, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            break;
+        }
+        seq = __atomic_load_n(&sequencer->pending_feel_sequence[index], __ATOMIC_RELAXED);
+    }
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    return &sequencer->pending_feel[index];
+}
 
-        // Get events from track
-        int event_count = 0;
-        const MednessTrackEvent* events = medness_track_get_events(slot->track, &event_count);
-        if (!events) continue;
+// Internal: Unlock a staged feel, handing it to the audio thread if it changed
+static void medness_sequencer_end_feel(MednessSequencer* sequencer, int index, int changed) {
+    __atomic_fetch_add(&sequencer->pending_feel_sequence[index], 1, __ATOMIC_RELEASE);
+    if (changed) {
+        __atomic_fetch_or(&sequencer->pending_feel_dirty, (uint64_t)1 << index, __ATOMIC_RELEASE);
+    }
+}
 
-        // Fire events between old_tick and new_tick
-        for (int e = 0; e < event_count; e++) {
-            const MednessTrackEvent* evt = &events[e];
+// Internal: Copy a groove template, clamping it to valid ranges
+static void medness_sequencer_copy_groove(MednessGroove* dst, const MednessGroove* src) {
+    *dst = *src;
+    if (dst->steps < 1) dst->steps = 1;
+    if (dst->steps > MEDNESS_GROOVE_MAX_STEPS) dst->steps = MEDNESS_GROOVE_MAX_STEPS;
+    for (int i = 0; i < MEDNESS_GROOVE_MAX_STEPS; i++) {
+        if (dst->timing[i] < -0.5f) dst->timing[i] = -0.5f;
+        if (dst->timing[i] > 0.5f) dst->timing[i] = 0.5f;
+        if (dst->velocity[i] < -127) dst->velocity[i] = -127;
+        if (dst->velocity[i] > 127) dst->velocity[i] = 127;
+    }
+}
 
-            if (evt->tick > slot->last_tick_processed && evt->tick <= new_tick) {
-                // Fire MIDI event
-                if (slot->midi_callback) {
-                    slot->midi_callback(evt->note, evt->velocity, evt->on, slot->userdata);
-                }
-            }
-        }
+// Internal: Stage a swing amount (already clamped)
+static void medness_sequencer_stage_swing(MednessSequencer* sequencer, int index, float amount) {
+    MednessSequencerFeel* feel = medness_sequencer_begin_feel(sequencer, index);
+    int changed = (feel->swing != amount);
+    feel->swing = amount;
+    medness_sequencer_end_feel(sequencer, index, changed);
+}
+
+// Internal: Stage a groove template (NULL = none)
+static void medness_sequencer_stage_groove(MednessSequencer* sequencer, int index, const MednessGroove* groove) {
+    MednessGroove clamped;
+    if (groove) medness_sequencer_copy_groove(&clamped, groove);
+
+    MednessSequencerFeel* feel = medness_sequencer_begin_feel(sequencer, index);
+    int changed;
+    if (!groove) {
+        changed = feel->has_groove;
+        feel->has_groove = 0;
+    } else {
+        changed = !feel->has_groove || memcmp(&feel->groove, &clamped, sizeof(clamped)) != 0;
+        feel->groove = clamped;
+        feel->has_groove = 1;
+    }
+    medness_sequencer_end_feel(sequencer, index, changed);
+}
 
-        slot->last_tick_processed = new_tick;
+void medness_sequencer_set_swing(MednessSequencer* sequencer, float amount) {
+    if (!sequencer) return;
+    if (amount < 0.0f) amount = 0.0f;
+    if (amount > 1.0f) amount = 1.0f;
+    medness_sequencer_stage_swing(sequencer, GLOBAL_FEEL, amount);
+}
+
+float medness_sequencer_get_swing(MednessSequencer* sequencer) {
+    if (!sequencer) return 0.0f;
+    MednessSequencerFeel feel;
+    medness_sequencer_read_feel(sequencer, GLOBAL_FEEL, &feel, 1);
+    return feel.swing;
+}
+
+void medness_sequencer_set_slot_swing(MednessSequencer* sequencer, int slot, float amount) {
+    if (!sequencer || slot < 0 || slot >= MAX_TRACK_SLOTS) return;
+    if (amount < 0.0f) {
+        amount = -1.0f;  // Follow the global swing
+    } else if (amount > 1.0f) {
+        amount = 1.0f;
     }
+    medness_sequencer_stage_swing(sequencer, slot, amount);
+}
+
+float medness_sequencer_get_slot_swing(MednessSequencer* sequencer, int slot) {
+    if (!sequencer || slot < 0 || slot >= MAX_TRACK_SLOTS) return -1.0f;
+    MednessSequencerFeel feel;
+    medness_sequencer_read_feel(sequencer, slot, &feel, 1);
+    return feel.swing;
+}
+
+void medness_sequencer_set_groove(MednessSequencer* sequencer, const MednessGroove* groove) {
+    if (!sequencer) return;
+    medness_sequencer_stage_groove(sequencer, GLOBAL_FEEL, groove);
+}
+
+void medness_sequencer_set_slot_groove(MednessSequencer* sequencer, int slot, const MednessGroove* groove) {
+    if (!sequencer || slot < 0 || slot >= MAX_TRACK_SLOTS) return;
+    medness_sequencer_stage_groove(sequencer, slot, groove);
+}
+
+// MIDI output
+
+void medness_sequencer_set_midi_output_callback(MednessSequencer* sequencer,
+                                                SequencerMidiOutputCallback callback, void* userdata) {
+    if (!sequencer) return;
+    sequencer->midi_output_callback = callback;
+    sequencer->midi_output_userdata = userdata;
+}
+
+void medness_sequencer_set_slot_midi_output(MednessSequencer* sequencer, int slot, int channel) {
+    if (!sequencer || slot < 0 || slot >= MAX_TRACK_SLOTS) return;
+    if (channel < -1 || channel > 15) channel = -1;
+
+    // Taken over by the audio thread at the next block
+    if (__atomic_load_n(&sequencer->pending_midi_output[slot], __ATOMIC_ACQUIRE) == channel) return;
+    __atomic_store_n(&sequencer->pending_midi_output[slot], channel, __ATOMIC_RELEASE);
+    __atomic_fetch_or(&sequencer->pending_output_dirty, 1u << slot, __ATOMIC_ACQ_REL);
+}
+
+int medness_sequencer_get_slot_midi_output(MednessSequencer* sequencer, int slot) {
+    if (!sequencer || slot < 0 || slot >= MAX_TRACK_SLOTS) return -1;
+    return __atomic_load_n(&sequencer->pending_midi_output[slot], __ATOMIC_ACQUIRE);
 }
@@ -2,6 +2,7 @@
 #define MEDNESS_SEQUENCER_H
 
 #include "medness_track.h"
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -14,12 +15,28 @@ extern "C" {
 typedef struct MednessSequencer MednessSequencer;
 typedef struct MednessSequencerTrackSlot MednessSequencerTrackSlot;
 
-// Callback fired when the pattern wraps from row 64 back to row 1
+// Callback fired when the pattern wraps from its last row back to row 1
 typedef void (*SequencerLoopCallback)(void* userdata);
 
 // Callback fired when a MIDI event needs to be sent
-// note: MIDI note number, velocity: 0-127, on: 1=note_on 0=note_off, userdata: user context
-typedef void (*SequencerMidiCallback)(int note, int velocity, int on, void* userdata);
+// note: MIDI note number, velocity: 0-127, on: 1=note_on 0=note_off,
+// frame_offset: frame within the current audio block where the event falls, userdata: user context
+typedef void (*SequencerMidiCallback)(int note, int velocity, int on, int frame_offset, void* userdata);
+
+// Callback for events of slots routed to the MIDI output (notes, controllers,
+// program changes; see medness_sequencer_set_slot_midi_output)
+// evt: the track event, channel: output channel of the slot (0-15),
+// frame_offset: frame within the current audio block where the event falls
+typedef void (*SequencerMidiOutputCallback)(const MednessTrackEvent* evt, int channel, int frame_offset, void* userdata);
+
+// Groove template: timing and velocity offsets per 16th note, repeating every
+// 'steps' 16ths from the start of each slot's loop
+#define MEDNESS_GROOVE_MAX_STEPS 32
+typedef struct {
+    int steps;                              // Template length in 16ths (1 to MEDNESS_GROOVE_MAX_STEPS)
+    float timing[MEDNESS_GROOVE_MAX_STEPS]; // Offset in 16ths (-0.5 to 0.5, + = late)
+    int velocity[MEDNESS_GROOVE_MAX_STEPS]; // Added to note-on velocities (result kept in 1-127)
+} MednessGroove;
 
 // Create a new sequencer
 MednessSequencer* medness_sequencer_create(void);
@@ -28,31 +45,74 @@ MednessSequencer* medness_sequencer_create(void);
 void medness_sequencer_destroy(MednessSequencer* sequencer);
 
 // Set the BPM (beats per minute)
+// Safe from any thread: takes effect at the start of the next update() block
 void medness_sequencer_set_bpm(MednessSequencer* sequencer, float bpm);
 
-// Get the current BPM
+// Get the current BPM (the most recently set value)
 float medness_sequencer_get_bpm(MednessSequencer* sequencer);
 
+// Shift the song position by 'pulses' (positive = jump ahead), e.g. phase
+// correction when slaved to an external clock
+// Safe from any thread: corrections accumulate until the next update() block
+void medness_sequencer_adjust_phase(MednessSequencer* sequencer, double pulses);
+
+// Set the host time (microseconds, any monotonic clock) at which the next
+// update() block starts; enables medness_sequencer_get_position_at()
+void medness_sequencer_set_block_time(MednessSequencer* sequencer, uint64_t host_time_us);
+
+// Get the song position (pulses) the sequencer had at a host time, extrapolated
+// from the last block. Safe from any thread.
+// Returns 0 on success, -1 if the sequencer isn't running or block times aren't set
+int medness_sequencer_get_position_at(MednessSequencer* sequencer, uint64_t host_time_us, double* out_song_pulse);
+
 // Set the pattern position from external SPP (Song Position Pointer)
 // spp_position: MIDI SPP value (in 16th notes)
+// Safe from any thread: takes effect at the start of the next update() block
 void medness_sequencer_set_spp(MednessSequencer* sequencer, int spp_position);
 
 // Update the sequencer with time delta (called from audio callback)
 // num_samples: number of audio samples processed
 // sample_rate: audio sample rate (e.g., 44100)
-// Returns: current pulse count (0-383), or -1 if not active
+// Pending settings are applied first, so num_samples 0 just applies them
+// Returns: current pulse within the pattern, or -1 if not active
 int medness_sequencer_update(MednessSequencer* sequencer, int num_samples, int sample_rate);
 
 // Advance position by one MIDI clock pulse (called when receiving 0xF8)
 void medness_sequencer_clock_pulse(MednessSequencer* sequencer);
 
-// Get current row position (1-64)
+// Get current row position (1 to pattern rows; a row is a 16th note)
 int medness_sequencer_get_row(MednessSequencer* sequencer);
 
-// Get current pulse within pattern (0-383)
+// Get current pulse within pattern (0 to pattern length - 1)
 int medness_sequencer_get_pulse(MednessSequencer* sequencer);
 
-// Set loop callback (called when pattern wraps)
+// Get the song position in pulses (24 PPQN, fractional, not wrapped at the pattern)
+// Derived from the sample counter and the last tempo change, so it does not drift
+double medness_sequencer_get_song_position(MednessSequencer* sequencer);
+
+// Get the number of frames the sequencer has advanced since creation
+int64_t medness_sequencer_get_sample_position(MednessSequencer* sequencer);
+
+// Set the time signature (default 4/4)
+// beat_unit: note value of one beat (1, 2, 4, 8, 16 or 32)
+// The pattern keeps its bar count; derived slot loop lengths follow the new bar length
+// Safe from any thread: takes effect at the start of the next update() block
+// (the getter returns the most recently set value)
+void medness_sequencer_set_time_signature(MednessSequencer* sequencer, int beats_per_bar, int beat_unit);
+void medness_sequencer_get_time_signature(MednessSequencer* sequencer, int* beats_per_bar, int* beat_unit);
+
+// Set the global pattern length in bars (default 4)
+// The pattern drives the row display and the loop callback; slots loop independently
+// Safe from any thread: takes effect at the start of the next update() block
+void medness_sequencer_set_pattern_bars(MednessSequencer* sequencer, int bars);
+int medness_sequencer_get_pattern_bars(MednessSequencer* sequencer);
+
+// Get the global pattern length in pulses (24 PPQN) and in rows (16th notes)
+int medness_sequencer_get_pattern_length(MednessSequencer* sequencer);
+int medness_sequencer_get_pattern_rows(MednessSequencer* sequencer);
+
+// Set loop callback (called when the global pattern wraps)
+// For per-track loop handling use medness_sequencer_set_slot_loop_callback()
 void medness_sequencer_set_loop_callback(MednessSequencer* sequencer, SequencerLoopCallback callback, void* userdata);
 
 // Enable/disable the sequencer
@@ -69,7 +129,7 @@ void medness_sequencer_set_external_clock(MednessSequencer* sequencer, int exter
 // --- Track Management ---
 
 // Add a track to a specific slot (0-15, matching pad indices)
-// The sequencer will play this track when active
+// The sequencer will play this track when active, looping it at the slot's loop length
 // track: the track to play (sequencer doesn't own it, just references it)
 // slot: which slot to assign (0-15)
 // midi_callback: callback for MIDI events from this track
@@ -83,6 +143,61 @@ void medness_sequencer_remove_track(MednessSequencer* sequencer, int slot);
 // Check if a slot has an active track
 int medness_sequencer_slot_is_active(MednessSequencer* sequencer, int slot);
 
+// Set a slot's loop length in pulses (24 PPQN)
+// length_pulses: explicit length, or 0 to derive it from the track length
+// rounded up to whole bars (the default)
+// A slot setting, kept when tracks are added or removed. Safe from any
+// thread: takes effect at the start of the next update() block
+void medness_sequencer_set_slot_loop_length(MednessSequencer* sequencer, int slot, int length_pulses);
+
+// Get a slot's current loop length in pulses
+int medness_sequencer_get_slot_loop_length(MednessSequencer* sequencer, int slot);
+
+// Set a slot's loop callback (called each time the slot's own loop wraps,
+// before the first event of the next pass is played)
+// The callback may remove the slot's track or replace it with add_track(); a
+// replacement starts at the loop point. Cleared by medness_sequencer_remove_track(),
+// so set it again after each add_track().
+void medness_sequencer_set_slot_loop_callback(MednessSequencer* sequencer, int slot,
+                                              SequencerLoopCallback callback, void* userdata);
+
+// --- Groove ---
+// Swing and groove move events at playback time (the track data is left as
+// is), so one phrase can be played with different feels. Setters may be
+// called from any thread but the audio thread; they take effect at the start
+// of the next update() block.
+
+// Set the global swing: 0.0 = straight, 1.0 = every second 16th delayed to
+// a dotted 16th (75% swing). Applies to slots without their own swing.
+void medness_sequencer_set_swing(MednessSequencer* sequencer, float amount);
+float medness_sequencer_get_swing(MednessSequencer* sequencer);
+
+// Set a slot's swing (0.0-1.0), or -1 to follow the global swing (default)
+void medness_sequencer_set_slot_swing(MednessSequencer* sequencer, int slot, float amount);
+float medness_sequencer_get_slot_swing(MednessSequencer* sequencer, int slot);
+
+// Set the global groove template (copied; NULL = none). Applies to slots
+// without their own template.
+void medness_sequencer_set_groove(MednessSequencer* sequencer, const MednessGroove* groove);
+
+// Set a slot's groove template (copied), or NULL to follow the global one (default)
+void medness_sequencer_set_slot_groove(MednessSequencer* sequencer, int slot, const MednessGroove* groove);
+
+// --- MIDI Output ---
+
+// Set the callback that receives events of slots routed to the MIDI output
+void medness_sequencer_set_midi_output_callback(MednessSequencer* sequencer,
+                                                SequencerMidiOutputCallback callback, void* userdata);
+
+// Route a slot's events to the MIDI output on 'channel' (0-15) instead of its
+// MIDI callback, or back to the callback with -1 (the default). A slot
+// setting: kept when tracks are added or removed. Safe from any thread: the
+// audio thread reroutes at its next block. Rerouting a slot or removing its
+// track ends the notes it left on: All Notes Off on a MIDI channel, note offs
+// through the callback for the internal route.
+void medness_sequencer_set_slot_midi_output(MednessSequencer* sequencer, int slot, int channel);
+int medness_sequencer_get_slot_midi_output(MednessSequencer* sequencer, int slot);
+
 #ifdef __cplusplus
 }
 #endif
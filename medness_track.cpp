@@ -2,19 +2,58 @@
 #include "MidiFile.h"
 #include <vector>
 #include <algorithm>
+#include <math.h>
 
 using namespace smf;
 
+// Tempo assumed before the first tempo event (MIDI file default)
+#define DEFAULT_FILE_BPM 120.0f
+
 struct MednessTrack {
     std::vector<MednessTrackEvent> events;
+    std::vector<MednessTrackTempo> tempo_map;   // Never empty (entry 0 at tick 0)
     int ticks_per_quarter;
     int duration_ticks;
+    int length_ticks;       // Up to the last event of any kind (end-of-track meta included)
 };
 
+// Reset the tempo map to a single constant tempo
+static void medness_track_reset_tempo_map(MednessTrack* track) {
+    MednessTrackTempo tempo;
+    tempo.tick = 0;
+    tempo.bpm = DEFAULT_FILE_BPM;
+    tempo.pulse = 0.0;
+    track->tempo_map.clear();
+    track->tempo_map.push_back(tempo);
+}
+
+// Find the tempo map entry in effect at 'tick'
+static const MednessTrackTempo* medness_track_find_tempo(MednessTrack* track, int tick) {
+    auto it = std::upper_bound(track->tempo_map.begin(), track->tempo_map.end(), tick,
+                               [](int t, const MednessTrackTempo& tempo) { return t < tempo.tick; });
+    if (it != track->tempo_map.begin()) --it;
+    return &(*it);
+}
+
+// Pulses per tick within a tempo segment. The tempo at tick 0 plays at the
+// sequencer BPM; a segment at twice that tempo covers half as many pulses.
+static double medness_track_segment_rate(MednessTrack* track, const MednessTrackTempo* tempo) {
+    return 24.0 / track->ticks_per_quarter * (track->tempo_map[0].bpm / tempo->bpm);
+}
+
+// Order of events at the same tick: program, controller, note off, note on
+static int medness_track_event_order(const MednessTrackEvent* evt) {
+    if (evt->type == MEDNESS_TRACK_EVENT_PROGRAM) return 0;
+    if (evt->type == MEDNESS_TRACK_EVENT_CONTROL) return 1;
+    return evt->on ? 3 : 2;
+}
+
 MednessTrack* medness_track_create(void) {
     MednessTrack* track = new MednessTrack();
     track->ticks_per_quarter = 480;  // Default TPQN
     track->duration_ticks = 0;
+    track->length_ticks = 0;
+    medness_track_reset_tempo_map(track);
     return track;
 }
 
@@ -39,42 +78,99 @@ int medness_track_load_midi_file(MednessTrack* track, const char* filename) {
     midifile.linkNotePairs();
 
     track->ticks_per_quarter = midifile.getTicksPerQuarterNote();
+    if (track->ticks_per_quarter <= 0) track->ticks_per_quarter = 480;  // SMPTE timing not supported
+
+    // Build the tempo map from tempo meta events (usually all in track 0)
+    medness_track_reset_tempo_map(track);
+    for (int t = 0; t < midifile.getTrackCount(); t++) {
+        for (int e = 0; e < midifile[t].size(); e++) {
+            MidiEvent& me = midifile[t][e];
+            if (!me.isTempo()) continue;
+
+            MednessTrackTempo tempo;
+            tempo.tick = me.tick;
+            tempo.bpm = (float)me.getTempoBPM();
+            tempo.pulse = 0.0;
+            if (tempo.bpm <= 0.0f) continue;
+            track->tempo_map.push_back(tempo);
+        }
+    }
+    std::stable_sort(track->tempo_map.begin(), track->tempo_map.end(),
+                     [](const MednessTrackTempo& a, const MednessTrackTempo& b) {
+                         return a.tick < b.tick;
+                     });
+
+    // Collapse changes at the same tick (the last one wins, so a tempo at
+    // tick 0 replaces the default entry)
+    std::vector<MednessTrackTempo> merged;
+    for (const MednessTrackTempo& tempo : track->tempo_map) {
+        if (!merged.empty() && merged.back().tick == tempo.tick) {
+            merged.back() = tempo;
+        } else {
+            merged.push_back(tempo);
+        }
+    }
+    track->tempo_map.swap(merged);
+
+    // Pulse position of each tempo change
+    for (size_t i = 1; i < track->tempo_map.size(); i++) {
+        const MednessTrackTempo* prev = &track->tempo_map[i - 1];
+        track->tempo_map[i].pulse = prev->pulse +
+            (track->tempo_map[i].tick - prev->tick) * medness_track_segment_rate(track, prev);
+    }
 
-    // Extract note events from all tracks
+    // Extract note, controller and program events from all tracks
     track->events.clear();
+    track->length_ticks = 0;
 
     for (int t = 0; t < midifile.getTrackCount(); t++) {
         for (int e = 0; e < midifile[t].size(); e++) {
             MidiEvent& me = midifile[t][e];
+            if (me.tick > track->length_ticks) track->length_ticks = me.tick;
 
+            MednessTrackEvent evt;
+            evt.tick = me.tick;
+            evt.pulse = 0.0;
+            evt.on = 0;
+            evt.velocity = 0;
             if (me.isNoteOn()) {
-                MednessTrackEvent evt;
-                evt.tick = me.tick;
+                evt.type = MEDNESS_TRACK_EVENT_NOTE;
                 evt.note = me.getKeyNumber();
                 evt.velocity = me.getVelocity();
                 evt.on = 1;
-                track->events.push_back(evt);
             } else if (me.isNoteOff()) {
-                MednessTrackEvent evt;
-                evt.tick = me.tick;
+                evt.type = MEDNESS_TRACK_EVENT_NOTE;
                 evt.note = me.getKeyNumber();
-                evt.velocity = 0;
-                evt.on = 0;
-                track->events.push_back(evt);
+            } else if (me.isController()) {
+                evt.type = MEDNESS_TRACK_EVENT_CONTROL;
+                evt.note = me.getP1();
+                evt.velocity = me.getP2();
+            } else if (me.isPatchChange()) {
+                evt.type = MEDNESS_TRACK_EVENT_PROGRAM;
+                evt.note = me.getP1();
+            } else {
+                continue;
             }
+            evt.channel = me.getChannel();
+            track->events.push_back(evt);
         }
     }
 
-    // Sort events by tick, with NOTE OFFs before NOTE ONs at the same tick
+    // Sort events by tick. At the same tick: program changes, then
+    // controllers (so a note starts with the new sound), then NOTE OFFs
+    // before NOTE ONs
     std::sort(track->events.begin(), track->events.end(),
               [](const MednessTrackEvent& a, const MednessTrackEvent& b) {
                   if (a.tick == b.tick) {
-                      // At same tick: OFF (0) before ON (1)
-                      return a.on < b.on;
+                      return medness_track_event_order(&a) < medness_track_event_order(&b);
                   }
                   return a.tick < b.tick;
               });
 
+    for (MednessTrackEvent& evt : track->events) {
+        evt.pulse = medness_track_tick_to_pulse(track, evt.tick);
+    }
+
     // Calculate duration
     if (!track->events.empty()) {
         track->duration_ticks = track->events.back().tick;
@@ -111,7 +207,43 @@ int medness_track_get_duration_ticks(MednessTrack* track) {
     return track->duration_ticks;
 }
 
+int medness_track_get_length_ticks(MednessTrack* track) {
+    if (!track) return 0;
+    return track->length_ticks;
+}
+
 int medness_track_get_tpqn(MednessTrack* track) {
     if (!track) return 480;
     return track->ticks_per_quarter;
 }
+
+const MednessTrackTempo* medness_track_get_tempo_map(MednessTrack* track, int* out_count) {
+    if (!track) {
+        if (out_count) *out_count = 0;
+        return nullptr;
+    }
+    if (out_count) *out_count = (int)track->tempo_map.size();
+    return track->tempo_map.data();
+}
+
+float medness_track_get_tempo_bpm(MednessTrack* track) {
+    if (!track) return DEFAULT_FILE_BPM;
+    return track->tempo_map[0].bpm;
+}
+
+double medness_track_tick_to_pulse(MednessTrack* track, int tick) {
+    if (!track) return tick * 24.0 / 480;
+    const MednessTrackTempo* tempo = medness_track_find_tempo(track, tick);
+    return tempo->pulse + (tick - tempo->tick) * medness_track_segment_rate(track, tempo);
+}
+
+int medness_track_pulse_to_tick(MednessTrack* track, double pulse) {
+    if (!track) return (int)(pulse * 480 / 24.0);
+
+    // Last tempo change at or before this pulse
+    auto it = std::upper_bound(track->tempo_map.begin(), track->tempo_map.end(), pulse,
+                               [](double p, const MednessTrackTempo& tempo) { return p < tempo.pulse; });
+    if (it != track->tempo_map.begin()) --it;
+    const MednessTrackTempo* tempo = &(*it);
+    return tempo->tick + (int)floor((pulse - tempo->pulse) / medness_track_segment_rate(track, tempo));
+}
@@ -10,14 +10,29 @@ extern "C" {
 
 typedef struct MednessTrack MednessTrack;
 
+// Track event types
+#define MEDNESS_TRACK_EVENT_NOTE     0   // Note on/off
+#define MEDNESS_TRACK_EVENT_CONTROL  1   // Control change: note = controller, velocity = value
+#define MEDNESS_TRACK_EVENT_PROGRAM  2   // Program change: note = program
+
 // MIDI event in a track
 typedef struct {
     int tick;           // MIDI tick when event occurs
     int note;           // MIDI note number
     int velocity;       // Note velocity (0-127)
     int on;             // 1=note_on, 0=note_off
+    double pulse;       // Position in 24 PPQN pulses (tempo map applied)
+    int type;           // MEDNESS_TRACK_EVENT_*
+    int channel;        // MIDI channel in the file (0-15)
 } MednessTrackEvent;
 
+// Tempo change in a track (from MIDI tempo meta events)
+typedef struct {
+    int tick;           // MIDI tick where the tempo takes effect
+    float bpm;          // Tempo from this tick on
+    double pulse;       // Position in 24 PPQN pulses
+} MednessTrackTempo;
+
 // Create a new empty track
 MednessTrack* medness_track_create(void);
 
@@ -42,9 +57,25 @@ const MednessTrackEvent* medness_track_get_events(MednessTrack* track, int* out_
 // Get track duration in ticks
 int medness_track_get_duration_ticks(MednessTrack* track);
 
+// Get track length in ticks, up to the end-of-track marker (so trailing rests
+// written into the file count towards the length)
+int medness_track_get_length_ticks(MednessTrack* track);
+
 // Get ticks per quarter note (from MIDI file)
 int medness_track_get_tpqn(MednessTrack* track);
 
+// Get the tempo map (sorted by tick, first entry at tick 0)
+// Returns pointer to tempo array, count is written to out_count
+const MednessTrackTempo* medness_track_get_tempo_map(MednessTrack* track, int* out_count);
+
+// Get the tempo at tick 0 (reference tempo: the sequencer BPM plays the file
+// at this tempo, later tempo changes are applied relative to it)
+float medness_track_get_tempo_bpm(MednessTrack* track);
+
+// Convert between the track's tick domain and 24 PPQN pulses through the tempo map
+double medness_track_tick_to_pulse(MednessTrack* track, int tick);
+int medness_track_pulse_to_tick(MednessTrack* track, double pulse);
+
 #ifdef __cplusplus
 }
 #endif
@@ -3,15 +3,74 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <rtmidi_c.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
 
 static RtMidiInPtr midiin[MIDI_MAX_DEVICES] = {NULL};
 static MidiEventCallback midi_cb = NULL;
 static void *cb_userdata = NULL;
 
+// Per-device timeline built from rtmidi's message deltas (driver timestamps)
+static double device_time[MIDI_MAX_DEVICES];    // Integrated deltas (seconds)
+static double device_offset[MIDI_MAX_DEVICES];  // Host clock minus device timeline (seconds)
+static int device_time_valid[MIDI_MAX_DEVICES];
+
+// Offset tracking: the smallest observed delay is the best estimate; larger
+// ones are callback scheduling latency. Relax upwards slowly so drift between
+// the driver clock and the host clock is still followed.
+#define OFFSET_RELAX 0.001
+
+uint64_t midi_get_time_us(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (uint64_t)((double)now.QuadPart * 1000000.0 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)(ts.tv_nsec / 1000);
+#endif
+}
+
+// Map a message's rtmidi delta onto the host clock: integrating the deltas
+// removes the jitter of when the callback happened to run
+static uint64_t midi_event_timestamp(int device_id, double dt) {
+    uint64_t now_us = midi_get_time_us();
+    double now = (double)now_us * 1e-6;
+
+    if (device_id < 0 || device_id >= MIDI_MAX_DEVICES) return now_us;
+
+    if (!device_time_valid[device_id] || dt < 0.0) {
+        device_time[device_id] = 0.0;
+        device_offset[device_id] = now;
+        device_time_valid[device_id] = 1;
+    } else {
+        device_time[device_id] += dt;
+    }
+
+    double offset = now - device_time[device_id];
+    if (offset < device_offset[device_id]) {
+        device_offset[device_id] = offset;
+    } else {
+        device_offset[device_id] += (offset - device_offset[device_id]) * OFFSET_RELAX;
+    }
+
+    double t = device_time[device_id] + device_offset[device_id];
+    if (t > now) t = now;  // Never report an event in the future
+    return (uint64_t)(t * 1e6);
+}
+
 // Common MIDI event handler with SysEx support
 static void handle_midi_event(int device_id, double dt, const unsigned char *msg, size_t sz) {
     if (sz < 1) return;
 
+    uint64_t timestamp_us = midi_event_timestamp(device_id, dt);
+
     // Handle SysEx messages (0xF0 ... 0xF7)
     if (sz >= 5 && msg[0] == 0xF0) {
         // Try to parse as Samplecrate SysEx message (silently)
@@ -30,13 +89,13 @@ static void handle_midi_event(int device_id, double dt, const unsigned char *msg
             // Position is in "MIDI beats" (1/16th notes), LSB first
             unsigned char data1 = msg[1] & 0x7F;  // LSB
             unsigned char data2 = msg[2] & 0x7F;  // MSB
-            midi_cb(msg[0], data1, data2, device_id, cb_userdata);
+            midi_cb(msg[0], data1, data2, device_id, timestamp_us, cb_userdata);
             return;
         }
 
         unsigned char data1 = (sz >= 2) ? msg[1] : 0;
         unsigned char data2 = (sz >= 3) ? msg[2] : 0;
-        midi_cb(msg[0], data1, data2, device_id, cb_userdata);
+        midi_cb(msg[0], data1, data2, device_id, timestamp_us, cb_userdata);
     }
 }
 
@@ -119,6 +178,7 @@ int midi_init_multi(MidiEventCallback cb, void *userdata, const int *ports, int
         char port_name[64];
         snprintf(port_name, sizeof(port_name), "samplecrate-midi-in-%d", dev);
         rtmidi_open_port(midiin[dev], ports[dev], port_name);
+        device_time_valid[dev] = 0;  // New timeline for this port
         // Use callback matching device index (dev), not port number
         // This ensures device_id in callback matches the device slot (0 or 1)
         rtmidi_in_set_callback(midiin[dev], callbacks[dev], NULL);
@@ -1,6 +1,8 @@
 #ifndef MIDI_H
 #define MIDI_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -8,7 +10,10 @@ extern "C" {
 // Maximum number of MIDI input devices
 #define MIDI_MAX_DEVICES 3
 
-typedef void (*MidiEventCallback)(unsigned char status, unsigned char data1, unsigned char data2, int device_id, void *userdata);
+// timestamp_us: when the message arrived, on the midi_get_time_us() clock
+// (from the driver's per-message timing, so free of callback scheduling jitter)
+typedef void (*MidiEventCallback)(unsigned char status, unsigned char data1, unsigned char data2, int device_id,
+                                  uint64_t timestamp_us, void *userdata);
 
 /**
  * Initialize MIDI input and set the event callback.
@@ -24,6 +29,11 @@ int midi_init(MidiEventCallback cb, void *userdata, int port);
  */
 int midi_init_multi(MidiEventCallback cb, void *userdata, const int *ports, int num_ports);
 
+/**
+ * Monotonic host clock in microseconds (the clock of callback timestamps).
+ */
+uint64_t midi_get_time_us(void);
+
 /**
  * Deinitialize MIDI input.
  */
@@ -0,0 +1,132 @@
+#include "midi_clock_pll.h"
+#include <math.h>
+#include <string.h>
+
+// Default loop bandwidth: settles within a couple of beats, averages jitter
+// over roughly one beat at typical tempos
+#define PLL_DEFAULT_BANDWIDTH 1.0
+// Tempo range accepted for the first period estimate
+#define PLL_MIN_BPM 20.0
+#define PLL_MAX_BPM 400.0
+// Lock: at least one beat since (re)start with RMS error under this fraction of a period
+#define PLL_LOCK_PULSES 24
+#define PLL_LOCK_JITTER 0.1
+// Smoothing of the squared-error average (per pulse)
+#define PLL_METRIC_ALPHA 0.05
+
+void midi_clock_pll_init(MidiClockPll* pll, double bandwidth_hz) {
+    if (!pll) return;
+
+    memset(pll, 0, sizeof(*pll));
+    pll->bandwidth = (bandwidth_hz > 0.0) ? bandwidth_hz : PLL_DEFAULT_BANDWIDTH;
+}
+
+void midi_clock_pll_reset(MidiClockPll* pll) {
+    if (!pll) return;
+
+    double bandwidth = pll->bandwidth;
+    uint32_t missed = pll->missed;
+    uint32_t resyncs = pll->resyncs;
+    midi_clock_pll_init(pll, bandwidth);
+    pll->missed = missed;
+    pll->resyncs = resyncs;
+}
+
+int midi_clock_pll_pulse(MidiClockPll* pll, uint64_t timestamp_us) {
+    if (!pll) return 0;
+
+    double t = (double)timestamp_us * 1e-6;
+
+    // First pulse: only a phase reference
+    if (pll->pulses == 0) {
+        pll->next_time = t;
+        pll->last_timestamp = timestamp_us;
+        pll->pulses = 1;
+        return 0;
+    }
+
+    // Second pulse: first period estimate
+    if (pll->pulses == 1) {
+        double period = t - pll->next_time;
+        double bpm = (period > 0.0) ? 60.0 / (period * 24.0) : 0.0;
+        if (bpm < PLL_MIN_BPM || bpm > PLL_MAX_BPM) {
+            // Unusable interval (stalled or bursting source): use this pulse as the new reference
+            pll->next_time = t;
+            pll->last_timestamp = timestamp_us;
+            return 0;
+        }
+        pll->period = period;
+        pll->next_time = t + period;
+        pll->last_timestamp = timestamp_us;
+        pll->pulses = 2;
+        return 1;
+    }
+
+    // Prediction error against the expected pulse time
+    double error = t - pll->next_time;
+    int count = 1;
+
+    if (error > 0.5 * pll->period) {
+        // Gap of whole periods: pulses were lost on the way
+        int lost = (int)floor(error / pll->period + 0.5);
+        pll->next_time += lost * pll->period;
+        error = t - pll->next_time;
+        pll->missed += (uint32_t)lost;
+        count += lost;
+    }
+
+    if (fabs(error) > 0.5 * pll->period) {
+        // Pulse doesn't fit the current estimate at all (duplicate, tempo jump, restart)
+        pll->resyncs++;
+        midi_clock_pll_reset(pll);
+        pll->next_time = t;
+        pll->last_timestamp = timestamp_us;
+        pll->pulses = 1;
+        return 0;
+    }
+
+    // Second-order loop update: b and c from the bandwidth at the current period
+    double omega = 2.0 * 3.14159265358979 * pll->bandwidth * pll->period;
+    double b = sqrt(2.0) * omega;
+    double c = omega * omega;
+    pll->next_time += b * error + pll->period;
+    pll->period += c * error;
+    pll->last_timestamp = timestamp_us;
+    pll->pulses++;
+
+    // Lock metrics
+    pll->last_error = error;
+    pll->error_sq_avg += PLL_METRIC_ALPHA * (error * error - pll->error_sq_avg);
+    pll->locked = (pll->pulses >= PLL_LOCK_PULSES &&
+                   sqrt(pll->error_sq_avg) < PLL_LOCK_JITTER * pll->period) ? 1 : 0;
+
+    return count;
+}
+
+float midi_clock_pll_get_bpm(const MidiClockPll* pll) {
+    if (!pll || pll->pulses < 2 || pll->period <= 0.0) return 0.0f;
+    return (float)(60.0 / (pll->period * 24.0));
+}
+
+uint64_t midi_clock_pll_get_pulse_time(const MidiClockPll* pll) {
+    if (!pll) return 0;
+    if (pll->pulses < 2) return pll->last_timestamp;
+    // The loop has already advanced to the next prediction: step back one period
+    double t = pll->next_time - pll->period;
+    return (t > 0.0) ? (uint64_t)(t * 1e6) : 0;
+}
+
+int midi_clock_pll_is_locked(const MidiClockPll* pll) {
+    if (!pll) return 0;
+    return pll->locked;
+}
+
+float midi_clock_pll_get_jitter_us(const MidiClockPll* pll) {
+    if (!pll) return 0.0f;
+    return (float)(sqrt(pll->error_sq_avg) * 1e6);
+}
+
+float midi_clock_pll_get_error_us(const MidiClockPll* pll) {
+    if (!pll) return 0.0f;
+    return (float)(pll->last_error * 1e6);
+}
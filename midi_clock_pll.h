@@ -0,0 +1,57 @@
+#ifndef MIDI_CLOCK_PLL_H
+#define MIDI_CLOCK_PLL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Clock recovery for incoming MIDI clock (0xF8, 24 pulses per quarter note).
+// A second-order delay-locked loop predicts the time of each next pulse and
+// corrects period and phase from the prediction error, so timestamp jitter is
+// filtered out while tempo changes are still followed.
+
+typedef struct {
+    // Loop state (seconds)
+    double next_time;       // Predicted time of the next pulse
+    double period;          // Filtered pulse period
+    double bandwidth;       // Loop bandwidth in Hz
+    uint64_t last_timestamp;// Timestamp of the last pulse (microseconds)
+    int pulses;             // Pulses since the loop (re)started
+
+    // Lock-quality metrics
+    double error_sq_avg;    // Smoothed squared prediction error (seconds^2)
+    double last_error;      // Last prediction error (seconds, + = pulse came late)
+    int locked;             // Loop settled: jitter small relative to the period
+    uint32_t missed;        // Pulses inferred as lost (gap of whole periods)
+    uint32_t resyncs;       // Loop restarts after an unusable pulse
+} MidiClockPll;
+
+// Initialize the loop (bandwidth_hz: 0 = default; lower = smoother, slower to follow)
+void midi_clock_pll_init(MidiClockPll* pll, double bandwidth_hz);
+
+// Restart acquisition (clock stopped, transport restarted)
+void midi_clock_pll_reset(MidiClockPll* pll);
+
+// Feed one clock pulse with its timestamp in microseconds
+// Returns the number of pulses this one accounts for: 1 normally, more if
+// pulses were lost in between, 0 while acquiring or after a restart
+int midi_clock_pll_pulse(MidiClockPll* pll, uint64_t timestamp_us);
+
+// Recovered tempo in BPM (0 until the first period is known)
+float midi_clock_pll_get_bpm(const MidiClockPll* pll);
+
+// Filtered time of the last pulse in microseconds (the loop's phase estimate)
+uint64_t midi_clock_pll_get_pulse_time(const MidiClockPll* pll);
+
+// Lock-quality metrics
+int midi_clock_pll_is_locked(const MidiClockPll* pll);
+float midi_clock_pll_get_jitter_us(const MidiClockPll* pll);    // RMS pulse timing error
+float midi_clock_pll_get_error_us(const MidiClockPll* pll);     // Last pulse timing error
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MIDI_CLOCK_PLL_H
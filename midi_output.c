@@ -1,11 +1,171 @@
 #include "midi_output.h"
+#include "midi_output_heap.h"
+#include "midi.h"
 #include <stdio.h>
+#include <string.h>
 #include <rtmidi_c.h>
 #include <unistd.h>
+#include <SDL.h>
+#ifdef _WIN32
+#include <windows.h>
+#include <mmsystem.h>
+#else
+#include <time.h>
+#endif
 
 // MIDI output state
 static RtMidiOutPtr midi_out = NULL;
 static int midi_out_device_id = -1;
+static SDL_mutex* send_mutex = NULL;    // Serializes rtmidi sends (UI sysex vs output thread)
+
+// Timed message queue (capacity must be a power of two). Same scheme as
+// samplecrate_event_queue.c: a cell is free for the producer claiming
+// position p when sequence == p, and published when sequence == p + 1.
+#define OUTPUT_QUEUE_SIZE 1024
+#define OUTPUT_QUEUE_MASK (OUTPUT_QUEUE_SIZE - 1)
+
+typedef struct {
+    uint64_t timestamp_us;
+    unsigned char data[3];
+    unsigned char size;
+    uint32_t sequence;
+} OutputQueueCell;
+
+static OutputQueueCell output_queue[OUTPUT_QUEUE_SIZE];
+static uint32_t output_enqueue_pos = 0;
+static uint32_t output_dequeue_pos = 0;     // Output thread only
+static uint32_t output_dropped = 0;
+static int output_open = 0;                 // Producers may push (queue initialized, thread running)
+
+// Messages taken off the queue, in time order (output thread only)
+static MidiOutputHeap output_pending;
+
+// Output thread
+static SDL_Thread* output_thread = NULL;
+static int output_thread_quit = 0;
+static SDL_sem* output_wake = NULL;         // Posted by producers while the thread waits
+static int output_waiting = 0;              // Thread is (about to be) blocked on output_wake
+
+// Messages more than this late are dropped instead of sent (e.g. queued
+// while the thread was stopped): a burst of stale clock would be worse
+#define OUTPUT_STALE_US 100000
+// Deadlines further out than this are waited for on output_wake (woken
+// early by new messages); the rest of the way is slept precisely
+#define OUTPUT_BLOCK_MARGIN_US 3000
+// Longest single precise sleep, so a message queued for earlier is noticed
+#define OUTPUT_MAX_SLEEP_US 1000
+
+static void output_queue_reset(void) {
+    memset(output_queue, 0, sizeof(output_queue));
+    for (uint32_t i = 0; i < OUTPUT_QUEUE_SIZE; i++) {
+        output_queue[i].sequence = i;
+    }
+    output_enqueue_pos = 0;
+    output_dequeue_pos = 0;
+    midi_output_heap_reset(&output_pending);
+}
+
+// Sleep until the host clock reaches target_us (at most OUTPUT_MAX_SLEEP_US)
+static void output_sleep_until(uint64_t target_us) {
+    uint64_t now = midi_get_time_us();
+    if (target_us <= now) return;
+    if (target_us - now > OUTPUT_MAX_SLEEP_US) target_us = now + OUTPUT_MAX_SLEEP_US;
+#ifdef _WIN32
+    // Millisecond resolution only: sleep the bulk, yield for the rest
+    if (target_us - now >= 1000) Sleep(1);
+    else Sleep(0);
+#else
+    // Same clock as midi_get_time_us(): absolute deadline, no drift from wakeup latency
+    struct timespec ts;
+    ts.tv_sec = (time_t)(target_us / 1000000ULL);
+    ts.tv_nsec = (long)(target_us % 1000000ULL) * 1000L;
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+#endif
+}
+
+// Whether a producer has published a message the thread hasn't taken yet
+static int output_queue_has_message(void) {
+    uint32_t pos = output_dequeue_pos;
+    uint32_t seq = __atomic_load_n(&output_queue[pos & OUTPUT_QUEUE_MASK].sequence, __ATOMIC_ACQUIRE);
+    return (int32_t)(seq - (pos + 1)) >= 0;
+}
+
+// Block until a producer queues a message, or until deadline_us (0 = no
+// deadline). Producers only post while output_waiting is set, so a busy
+// thread costs them nothing.
+static void output_wait(uint64_t deadline_us) {
+    // Announce the wait before re-checking, so a push after this point posts
+    __atomic_store_n(&output_waiting, 1, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (!output_queue_has_message() && !__atomic_load_n(&output_thread_quit, __ATOMIC_ACQUIRE)) {
+        if (deadline_us == 0) {
+            SDL_SemWait(output_wake);
+        } else {
+            uint64_t now = midi_get_time_us();
+            if (deadline_us > now) SDL_SemWaitTimeout(output_wake, (Uint32)((deadline_us - now + 999) / 1000));
+        }
+    }
+    __atomic_store_n(&output_waiting, 0, __ATOMIC_SEQ_CST);
+}
+
+static void output_send(const unsigned char *msg, size_t len) {
+    if (send_mutex) SDL_LockMutex(send_mutex);
+    if (midi_out) rtmidi_out_send_message(midi_out, msg, len);
+    if (send_mutex) SDL_UnlockMutex(send_mutex);
+}
+
+// Move queued messages into the time-ordered pending heap (as many as fit;
+// the rest wait in the queue)
+static void output_drain_queue(void) {
+    while (output_pending.count < MIDI_OUTPUT_HEAP_SIZE) {
+        uint32_t pos = output_dequeue_pos;
+        OutputQueueCell* cell = &output_queue[pos & OUTPUT_QUEUE_MASK];
+        uint32_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        if ((int32_t)(seq - (pos + 1)) < 0) return;  // Nothing more queued
+
+        midi_output_heap_push(&output_pending, cell->timestamp_us, cell->data, cell->size);
+
+        // Hand the cell back to producers for the next lap
+        __atomic_store_n(&cell->sequence, pos + OUTPUT_QUEUE_SIZE, __ATOMIC_RELEASE);
+        output_dequeue_pos = pos + 1;
+    }
+}
+
+static int output_thread_main(void *userdata) {
+    (void)userdata;
+
+    while (!__atomic_load_n(&output_thread_quit, __ATOMIC_ACQUIRE)) {
+        // Producers queue in call order, not time order (the audio callback
+        // queues a block's sequencer notes before its clock pulses), so send
+        // from the heap: earliest timestamp first
+        output_drain_queue();
+        const MidiOutputMessage* msg = midi_output_heap_peek(&output_pending);
+        if (!msg) {
+            // Nothing queued: sleep until a producer queues something
+            output_wait(0);
+            continue;
+        }
+
+        // Wait for the earliest to come due: block while it is far off (an
+        // earlier one queued meanwhile wakes us), then sleep precisely (an
+        // earlier one is picked up after at most OUTPUT_MAX_SLEEP_US)
+        uint64_t now = midi_get_time_us();
+        if (msg->timestamp_us > now + OUTPUT_BLOCK_MARGIN_US) {
+            output_wait(msg->timestamp_us - OUTPUT_BLOCK_MARGIN_US);
+            continue;
+        }
+        if (msg->timestamp_us > now) {
+            output_sleep_until(msg->timestamp_us);
+            continue;
+        }
+
+        if (now - msg->timestamp_us <= OUTPUT_STALE_US) {
+            output_send(msg->data, msg->size);
+        }
+        midi_output_heap_pop(&output_pending);
+    }
+    return 0;
+}
 
 int midi_output_list_ports(void) {
 #ifndef _WIN32
@@ -81,11 +241,44 @@ int midi_output_init(int device_id) {
 
     midi_out_device_id = device_id;
 
+    // Start the timed output thread (the queue is only touched by producers
+    // once output_open is set)
+    if (!send_mutex) send_mutex = SDL_CreateMutex();
+    if (!output_wake) output_wake = SDL_CreateSemaphore(0);
+    while (SDL_SemTryWait(output_wake) == 0) {}  // Drop wake-ups left from the last thread
+    output_queue_reset();
+    __atomic_store_n(&output_thread_quit, 0, __ATOMIC_RELEASE);
+    output_thread = SDL_CreateThread(output_thread_main, "midi-output", NULL);
+    if (output_thread) {
+#ifdef _WIN32
+        // 1 ms timer resolution while the output runs (the default ~15 ms
+        // would bunch up clock pulses)
+        timeBeginPeriod(1);
+#endif
+        __atomic_store_n(&output_open, 1, __ATOMIC_RELEASE);
+    } else {
+        fprintf(stderr, "[MIDI Output] Failed to start output thread: %s\n", SDL_GetError());
+    }
+
     printf("MIDI output initialized on device %d: %s\n", device_id, port_name);
     return 0;
 }
 
 void midi_output_deinit(void) {
+    // Stop the output thread first: it must not send on a closed port.
+    // A producer that already passed the output_open check may still finish
+    // its push; the queue is reset before the next thread starts.
+    __atomic_store_n(&output_open, 0, __ATOMIC_RELEASE);
+    if (output_thread) {
+        __atomic_store_n(&output_thread_quit, 1, __ATOMIC_RELEASE);
+        SDL_SemPost(output_wake);
+        SDL_WaitThread(output_thread, NULL);
+        output_thread = NULL;
+#ifdef _WIN32
+        timeEndPeriod(1);
+#endif
+    }
+
     if (midi_out) {
         rtmidi_close_port(midi_out);
         rtmidi_out_free(midi_out);
@@ -104,7 +297,76 @@ int midi_output_send_sysex(const unsigned char *msg, size_t msg_len) {
         return -1;
     }
 
-    rtmidi_out_send_message(midi_out, msg, msg_len);
+    output_send(msg, msg_len);
     // Silent - SysEx messages sent frequently
     return 0;
 }
+
+int midi_output_queue_message(const unsigned char *msg, int msg_len, uint64_t timestamp_us) {
+    if (!msg || msg_len < 1 || msg_len > 3) return -1;
+    if (!__atomic_load_n(&output_open, __ATOMIC_ACQUIRE)) return -1;
+
+    uint32_t pos = __atomic_load_n(&output_enqueue_pos, __ATOMIC_RELAXED);
+    for (;;) {
+        OutputQueueCell* cell = &output_queue[pos & OUTPUT_QUEUE_MASK];
+        uint32_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        int32_t diff = (int32_t)(seq - pos);
+
+        if (diff == 0) {
+            // Cell is free: try to claim this position
+            if (__atomic_compare_exchange_n(&output_enqueue_pos, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                cell->timestamp_us = timestamp_us;
+                memcpy(cell->data, msg, (size_t)msg_len);
+                cell->size = (unsigned char)msg_len;
+                __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+
+                // Wake the output thread if it is blocked (one post per wait)
+                __atomic_thread_fence(__ATOMIC_SEQ_CST);
+                if (__atomic_load_n(&output_waiting, __ATOMIC_SEQ_CST) &&
+                    __atomic_exchange_n(&output_waiting, 0, __ATOMIC_SEQ_CST)) {
+                    SDL_SemPost(output_wake);
+                }
+                return 0;
+            }
+            // pos was reloaded by the failed compare-and-swap
+        } else if (diff < 0) {
+            // Output thread has not freed this cell yet: queue is full
+            __atomic_fetch_add(&output_dropped, 1, __ATOMIC_RELAXED);
+            return -1;
+        } else {
+            // Another producer claimed it first
+            pos = __atomic_load_n(&output_enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+int midi_output_queue_note(int channel, int note, int velocity, int on, uint64_t timestamp_us) {
+    if (channel < 0 || channel > 15) return -1;
+    unsigned char msg[3];
+    msg[0] = (unsigned char)((on ? 0x90 : 0x80) | channel);
+    msg[1] = (unsigned char)(note & 0x7F);
+    msg[2] = (unsigned char)(velocity & 0x7F);
+    return midi_output_queue_message(msg, 3, timestamp_us);
+}
+
+int midi_output_queue_cc(int channel, int controller, int value, uint64_t timestamp_us) {
+    if (channel < 0 || channel > 15) return -1;
+    unsigned char msg[3];
+    msg[0] = (unsigned char)(0xB0 | channel);
+    msg[1] = (unsigned char)(controller & 0x7F);
+    msg[2] = (unsigned char)(value & 0x7F);
+    return midi_output_queue_message(msg, 3, timestamp_us);
+}
+
+int midi_output_queue_program(int channel, int program, uint64_t timestamp_us) {
+    if (channel < 0 || channel > 15) return -1;
+    unsigned char msg[2];
+    msg[0] = (unsigned char)(0xC0 | channel);
+    msg[1] = (unsigned char)(program & 0x7F);
+    return midi_output_queue_message(msg, 2, timestamp_us);
+}
+
+uint32_t midi_output_get_dropped(void) {
+    return __atomic_load_n(&output_dropped, __ATOMIC_RELAXED);
+}
@@ -2,6 +2,7 @@
 #define MIDI_OUTPUT_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -32,6 +33,32 @@ void midi_output_deinit(void);
 // Returns 0 on success, -1 on failure
 int midi_output_send_sysex(const unsigned char *msg, size_t msg_len);
 
+// Timed output: short messages (1-3 bytes: clock, start/stop, SPP, notes...)
+// go through a lock-free queue to a dedicated output thread, which sends each
+// one when the host clock (midi_get_time_us()) reaches its timestamp.
+// Messages may be queued in any time order: they are sent by timestamp, and
+// in queue order for equal timestamps. Safe to call from the audio thread:
+// never blocks or allocates (it only posts a semaphore when the output
+// thread is asleep waiting for work).
+// Returns 0 on success, -1 if no output is open or the queue is full (dropped)
+int midi_output_queue_message(const unsigned char *msg, int msg_len, uint64_t timestamp_us);
+
+// Timed channel messages (channel: 0-15), queued like midi_output_queue_message()
+// on: 1 = note on, 0 = note off
+int midi_output_queue_note(int channel, int note, int velocity, int on, uint64_t timestamp_us);
+int midi_output_queue_cc(int channel, int controller, int value, uint64_t timestamp_us);
+int midi_output_queue_program(int channel, int program, uint64_t timestamp_us);
+
+// Number of queued messages dropped so far (queue full)
+uint32_t midi_output_get_dropped(void);
+
+// MIDI realtime/system messages for clock master mode
+#define MIDI_OUTPUT_CLOCK       0xF8
+#define MIDI_OUTPUT_START       0xFA
+#define MIDI_OUTPUT_CONTINUE    0xFB
+#define MIDI_OUTPUT_STOP        0xFC
+#define MIDI_OUTPUT_SONG_POS    0xF2
+
 #ifdef __cplusplus
 }
 #endif
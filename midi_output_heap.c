@@ -0,0 +1,56 @@
+#include "midi_output_heap.h"
+#include <string.h>
+
+// a goes out before b
+static int heap_before(const MidiOutputMessage* a, const MidiOutputMessage* b) {
+    if (a->timestamp_us != b->timestamp_us) return a->timestamp_us < b->timestamp_us;
+    return (int32_t)(a->order - b->order) < 0;  // Wrap-safe
+}
+
+void midi_output_heap_reset(MidiOutputHeap* heap) {
+    heap->count = 0;
+    heap->next_order = 0;
+}
+
+int midi_output_heap_push(MidiOutputHeap* heap, uint64_t timestamp_us, const unsigned char* data, int size) {
+    if (heap->count >= MIDI_OUTPUT_HEAP_SIZE || !data || size < 1 || size > 3) return -1;
+
+    MidiOutputMessage msg;
+    msg.timestamp_us = timestamp_us;
+    msg.order = heap->next_order++;
+    memcpy(msg.data, data, (size_t)size);
+    msg.size = (unsigned char)size;
+
+    // Sift up from the new leaf
+    int i = heap->count++;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!heap_before(&msg, &heap->items[parent])) break;
+        heap->items[i] = heap->items[parent];
+        i = parent;
+    }
+    heap->items[i] = msg;
+    return 0;
+}
+
+const MidiOutputMessage* midi_output_heap_peek(const MidiOutputHeap* heap) {
+    return (heap->count > 0) ? &heap->items[0] : NULL;
+}
+
+void midi_output_heap_pop(MidiOutputHeap* heap) {
+    if (heap->count <= 0) return;
+
+    // Sift the last leaf down from the root
+    MidiOutputMessage last = heap->items[--heap->count];
+    int n = heap->count;
+    int i = 0;
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= n) break;
+        if (child + 1 < n && heap_before(&heap->items[child + 1], &heap->items[child])) child++;
+        if (!heap_before(&heap->items[child], &last)) break;
+        heap->items[i] = heap->items[child];
+        i = child;
+    }
+    if (n > 0) heap->items[i] = last;
+}
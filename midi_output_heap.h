@@ -0,0 +1,48 @@
+#ifndef MIDI_OUTPUT_HEAP_H
+#define MIDI_OUTPUT_HEAP_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Heap capacity in messages
+#define MIDI_OUTPUT_HEAP_SIZE 1024
+
+// Short MIDI message waiting for its send time
+typedef struct {
+    uint64_t timestamp_us;  // Host time to send at (midi_get_time_us() clock)
+    uint32_t order;         // Arrival number: keeps equal timestamps in push order
+    unsigned char data[3];
+    unsigned char size;     // 1-3 bytes
+} MidiOutputMessage;
+
+// Messages ordered by timestamp (binary min-heap). The MIDI output thread
+// moves everything producers queued into it and sends from the top, so
+// messages queued out of time order (e.g. a block's sequencer notes ahead of
+// its clock pulses) still go out in time order. Single thread, no locking.
+typedef struct {
+    MidiOutputMessage items[MIDI_OUTPUT_HEAP_SIZE];
+    int count;
+    uint32_t next_order;
+} MidiOutputHeap;
+
+// Reset to empty
+void midi_output_heap_reset(MidiOutputHeap* heap);
+
+// Add a message
+// Returns 0 on success, -1 if the heap is full or the message is invalid
+int midi_output_heap_push(MidiOutputHeap* heap, uint64_t timestamp_us, const unsigned char* data, int size);
+
+// Earliest message (first pushed among equal timestamps), or NULL if empty
+const MidiOutputMessage* midi_output_heap_peek(const MidiOutputHeap* heap);
+
+// Remove the earliest message
+void midi_output_heap_pop(MidiOutputHeap* heap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MIDI_OUTPUT_HEAP_H
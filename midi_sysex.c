@@ -457,6 +457,8 @@ const char* sysex_command_name(SysExCommand cmd) {
         case SYSEX_CMD_TRIGGER_PAD:    return "TRIGGER_PAD";
         case SYSEX_CMD_CHANNEL_PANNING: return "CHANNEL_PANNING";
         case SYSEX_CMD_MASTER_PANNING: return "MASTER_PANNING";
+        case SYSEX_CMD_CHANNEL_DELAY_SEND: return "CHANNEL_DELAY_SEND";
+        case SYSEX_CMD_CHANNEL_REVERB_SEND: return "CHANNEL_REVERB_SEND";
         case SYSEX_CMD_SEQUENCE_TRACK_UPLOAD: return "SEQUENCE_TRACK_UPLOAD";
         case SYSEX_CMD_SEQUENCE_TRACK_UPLOAD_RESPONSE: return "SEQUENCE_TRACK_UPLOAD_RESPONSE";
         case SYSEX_CMD_SEQUENCE_TRACK_PLAY:  return "SEQUENCE_TRACK_PLAY";
@@ -43,6 +43,8 @@ typedef enum {
     SYSEX_CMD_TRIGGER_PAD       = 0x50,  // Trigger a pad action
     SYSEX_CMD_CHANNEL_PANNING   = 0x58,  // Set channel/program panning
     SYSEX_CMD_MASTER_PANNING    = 0x59,  // Set master panning
+    SYSEX_CMD_CHANNEL_DELAY_SEND  = 0x5A,  // Set program send level into the shared delay bus
+    SYSEX_CMD_CHANNEL_REVERB_SEND = 0x5B,  // Set program send level into the shared reverb bus
     // Effects control (per-program)
     SYSEX_CMD_FX_EFFECT_GET     = 0x70,  // Get effect parameters by effect ID
     SYSEX_CMD_FX_EFFECT_SET     = 0x71,  // Set effect parameters by effect ID
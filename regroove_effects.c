@@ -3,6 +3,9 @@
 #include <string.h>
 #include <math.h>
 
+// Frames converted per pass by the int16 wrapper (stack buffers, no allocation)
+#define REGROOVE_EFFECTS_CHUNK_FRAMES 256
+
 // Helper: clamp float value
 static inline float clampf(float v, float min, float max) {
     if (v < min) return min;
@@ -10,6 +13,73 @@ static inline float clampf(float v, float min, float max) {
     return v;
 }
 
+// Phaser: LFO/all-pass coefficients are updated at this control rate (samples)
+#define PHASER_CONTROL_RATE 32
+
+// Reverb FDN line lengths at 48kHz (mutually prime, ~21ms - 58ms), scaled
+// down for lower sample rates; the buffer is preallocated for these lengths
+static const int reverb_base_lengths[REVERB_FDN_LINES] = {
+    1031, 1327, 1523, 1871, 2053, 2311, 2539, 2803
+};
+#define REVERB_BASE_RATE 48000.0f
+
+// Parameter smoothing time constant (seconds) and snap threshold
+#define REGROOVE_EFFECTS_SMOOTH_TIME 0.02f
+#define REGROOVE_EFFECTS_SMOOTH_EPSILON 0.0001f
+
+// Helpers: publish/read parameter targets across threads (setters may run on
+// the MIDI or UI thread while the audio thread is inside a block)
+static inline void store_param(float *target, float value) {
+#if defined(__GNUC__)
+    __atomic_store(target, &value, __ATOMIC_RELEASE);
+#else
+    *(volatile float *)target = value;
+#endif
+}
+
+static inline float load_param(const float *target) {
+#if defined(__GNUC__)
+    float value;
+    __atomic_load(target, &value, __ATOMIC_ACQUIRE);
+    return value;
+#else
+    return *(const volatile float *)target;
+#endif
+}
+
+// Helpers: install/read lazily allocated buffers. The installer runs on a
+// control thread; the audio thread only ever sees NULL or a complete buffer.
+static inline int publish_buffer(float **slot, float *buffer) {
+#if defined(__GNUC__)
+    float *expected = NULL;
+    return __atomic_compare_exchange_n(slot, &expected, buffer, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+#else
+    if (*(float * volatile *)slot) return 0;
+    *(float * volatile *)slot = buffer;
+    return 1;
+#endif
+}
+
+static inline float* acquire_buffer(float * const *slot) {
+#if defined(__GNUC__)
+    return __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+#else
+    return *(float * const volatile *)slot;
+#endif
+}
+
+// Helper: one block-rate smoothing step, returns 1 while still moving
+static inline int smooth_param(float *current, float target, float coeff) {
+    float diff = target - *current;
+    if (diff == 0.0f) return 0;
+    if (fabsf(diff) < REGROOVE_EFFECTS_SMOOTH_EPSILON) {
+        *current = target;
+    } else {
+        *current += diff * coeff;
+    }
+    return 1;
+}
+
 // Helper: Foldback distortion for aggressive harmonics
 static inline float foldback(float x) {
     const float threshold = 1.0f;
@@ -32,17 +102,20 @@ static inline float rb338_shaper(float x) {
     }
 }
 
+// Helper: One-pole coefficient for a normalized cutoff (cutoff_hz / sample_rate)
+static inline float onepole_alpha(float cutoff_norm) {
+    return 1.0f - expf(-2.0f * 3.14159f * cutoff_norm);
+}
+
 // Helper: Simple one-pole highpass filter for pre-emphasis
-static inline float highpass_tick(float input, float *state, float cutoff_norm) {
-    float alpha = 1.0f - expf(-2.0f * 3.14159f * cutoff_norm);
+static inline float highpass_tick(float input, float *state, float alpha) {
     *state += alpha * (input - *state);
     return input - *state;
 }
 
 // Helper: Simple resonant bandpass bump (for punch at 120Hz)
-static inline float bandpass_bump(float input, float *lp_state, float *bp_state, float freq_norm, float q) {
+static inline float bandpass_bump(float input, float *lp_state, float *bp_state, float f, float q) {
     // State-variable filter bandpass output
-    float f = 2.0f * sinf(3.14159f * freq_norm);
     *lp_state += f * *bp_state;
     float hp = input - *lp_state - q * *bp_state;
     *bp_state += f * hp;
@@ -57,18 +130,531 @@ static inline float envelope_follower(float input, float *state, float attack, f
     return *state;
 }
 
+// Recompute derived coefficients from the smoothed parameters.
+// Called from the audio thread at the start of a block, only while a
+// parameter is still ramping or the sample rate differs from the cached one.
+static void regroove_effects_update_coeffs(RegrooveEffects* fx, int sample_rate) {
+    const RegrooveEffectsParams* p = &fx->smoothed;
+    float sr = (float)sample_rate;
+
+    // Distortion (fixed-frequency pre/post filters + drive)
+    fx->coef_distortion_hp_alpha = onepole_alpha(80.0f / sr);
+    fx->coef_distortion_bp_f = 2.0f * sinf(3.14159f * (120.0f / sr));
+    fx->coef_distortion_lp_alpha = onepole_alpha(8000.0f / sr);
+    // Drive amount: 0.0 = 1x, 1.0 = 8x
+    fx->coef_distortion_drive = 1.0f + p->distortion_drive * 7.0f;
+
+    // Filter: normalized cutoff to actual frequency (linear mapping)
+    float freq = p->filter_cutoff * sr * 0.5f * 0.48f;
+    fx->coef_filter_f = 2.0f * sinf(3.14159265f * freq / sr);
+    // 0.0 resonance = q of 0.7 (gentle), 1.0 resonance = q of 0.1 (strong but stable)
+    float q = 0.7f - p->filter_resonance * 0.6f;
+    fx->coef_filter_q = (q < 0.1f) ? 0.1f : q;
+
+    // EQ: 250Hz / 6kHz splits, gains 0.25x to 4x with 1.0x at 0.5
+    fx->coef_eq_low_alpha = onepole_alpha(250.0f / sr);
+    fx->coef_eq_mid_alpha = onepole_alpha(6000.0f / sr);
+    fx->coef_eq_low_mult = powf(4.0f, (p->eq_low - 0.5f) * 2.0f);
+    fx->coef_eq_mid_mult = powf(4.0f, (p->eq_mid - 0.5f) * 2.0f);
+    fx->coef_eq_high_mult = powf(4.0f, (p->eq_high - 0.5f) * 2.0f);
+
+    // Compressor
+    // Attack: 0.5ms to 50ms, Release: 10ms to 500ms (0.0-1.0 maps to fast to slow)
+    float attack_time = 0.0005f + p->compressor_attack * 0.0495f;
+    float release_time = 0.01f + p->compressor_release * 0.49f;
+    fx->coef_comp_attack = 1.0f - expf(-1.0f / (sr * attack_time));
+    fx->coef_comp_release = 1.0f - expf(-1.0f / (sr * release_time));
+    // Threshold: 0.0-1.0 maps to -40dB to -6dB (linear domain: 0.01 to 0.5)
+    fx->coef_comp_threshold = 0.01f + p->compressor_threshold * 0.49f;
+    // Ratio: 0.0-1.0 maps to 1:1 to 20:1
+    fx->coef_comp_ratio = 1.0f + p->compressor_ratio * 19.0f;
+    // Makeup: 0.0-1.0 maps to 1/8x to 8x, 1x at 0.5
+    fx->coef_comp_makeup = powf(8.0f, (p->compressor_makeup - 0.5f) * 2.0f);
+
+    // Phaser: rate 0.05Hz - 5Hz, sweep from 300Hz up to 1 + 4 octaves * depth
+    fx->coef_phaser_lfo_inc = (0.05f + p->phaser_rate * 4.95f) / sr;
+    fx->coef_phaser_min_freq = 300.0f;
+    fx->coef_phaser_sweep = powf(2.0f, p->phaser_depth * 4.0f) - 1.0f;
+    fx->coef_phaser_feedback = p->phaser_feedback * 0.9f;
+
+    // Reverb: line lengths follow the sample rate (capped at the preallocated size)
+    float length_scale = (sr < REVERB_BASE_RATE) ? sr / REVERB_BASE_RATE : 1.0f;
+    for (int k = 0; k < REVERB_FDN_LINES; k++) {
+        int length = (int)(reverb_base_lengths[k] * length_scale);
+        if (length < 1) length = 1;
+        fx->reverb_length[k] = length;
+        if (fx->reverb_pos[k] >= length) fx->reverb_pos[k] = 0;
+    }
+
+    // Room size maps to RT60 of 0.3s - 5s; each line gets the gain that
+    // decays by 60dB over RT60 for its own length
+    float rt60 = 0.3f + p->reverb_room_size * 4.7f;
+    for (int k = 0; k < REVERB_FDN_LINES; k++) {
+        fx->coef_reverb_gain[k] = powf(10.0f, -3.0f * (float)fx->reverb_length[k] / (rt60 * sr));
+    }
+    fx->coef_reverb_damp = p->reverb_damping * 0.7f;
+
+    // Delay time in samples (0-1000ms)
+    int delay_samples = (int)(p->delay_time * sr);
+    if (delay_samples > MAX_DELAY_SAMPLES - 1) delay_samples = MAX_DELAY_SAMPLES - 1;
+    fx->coef_delay_samples = delay_samples;
+
+    fx->coeffs_sample_rate = sample_rate;
+    fx->coeffs_dirty = 0;
+}
+
+// Ramp the smoothed parameters one block toward the published targets.
+// Returns 1 if any parameter moved (coefficients need a refresh).
+static int regroove_effects_smooth_params(RegrooveEffects* fx, int frames, int sample_rate) {
+    RegrooveEffectsParams* p = &fx->smoothed;
+    float coeff = 1.0f - expf(-(float)frames / (REGROOVE_EFFECTS_SMOOTH_TIME * (float)sample_rate));
+    int moving = 0;
+
+#define SMOOTH(name) moving |= smooth_param(&p->name, load_param(&fx->name), coeff)
+    SMOOTH(distortion_drive);
+    SMOOTH(distortion_mix);
+    SMOOTH(filter_cutoff);
+    SMOOTH(filter_resonance);
+    SMOOTH(eq_low);
+    SMOOTH(eq_mid);
+    SMOOTH(eq_high);
+    SMOOTH(compressor_threshold);
+    SMOOTH(compressor_ratio);
+    SMOOTH(compressor_attack);
+    SMOOTH(compressor_release);
+    SMOOTH(compressor_makeup);
+    SMOOTH(phaser_rate);
+    SMOOTH(phaser_depth);
+    SMOOTH(phaser_feedback);
+    SMOOTH(reverb_room_size);
+    SMOOTH(reverb_damping);
+    SMOOTH(reverb_mix);
+    SMOOTH(delay_time);
+    SMOOTH(delay_feedback);
+    SMOOTH(delay_mix);
+#undef SMOOTH
+
+    return moving;
+}
+
+// Jump the smoothed parameters straight to their targets (no ramp)
+static void regroove_effects_snap_params(RegrooveEffects* fx) {
+    RegrooveEffectsParams* p = &fx->smoothed;
+    p->distortion_drive = fx->distortion_drive;
+    p->distortion_mix = fx->distortion_mix;
+    p->filter_cutoff = fx->filter_cutoff;
+    p->filter_resonance = fx->filter_resonance;
+    p->eq_low = fx->eq_low;
+    p->eq_mid = fx->eq_mid;
+    p->eq_high = fx->eq_high;
+    p->compressor_threshold = fx->compressor_threshold;
+    p->compressor_ratio = fx->compressor_ratio;
+    p->compressor_attack = fx->compressor_attack;
+    p->compressor_release = fx->compressor_release;
+    p->compressor_makeup = fx->compressor_makeup;
+    p->phaser_rate = fx->phaser_rate;
+    p->phaser_depth = fx->phaser_depth;
+    p->phaser_feedback = fx->phaser_feedback;
+    p->reverb_room_size = fx->reverb_room_size;
+    p->reverb_damping = fx->reverb_damping;
+    p->reverb_mix = fx->reverb_mix;
+    p->delay_time = fx->delay_time;
+    p->delay_feedback = fx->delay_feedback;
+    p->delay_mix = fx->delay_mix;
+}
+
+// Helper: First-order all-pass coefficient for a break frequency
+static inline float allpass_coeff(float freq, float sample_rate) {
+    float t = tanf(3.14159265f * freq / sample_rate);
+    return (t - 1.0f) / (t + 1.0f);
+}
+
+// Helper: First-order all-pass section (transposed direct form II, one state)
+static inline float allpass_tick(float input, float *state, float a) {
+    float output = a * input + *state;
+    *state = input - a * output;
+    return output;
+}
+
+// -----------------------------------------------------------------------------
+// Stereo kernels (filter, EQ, compressor)
+// Each kernel runs one stage over the whole block with L/R processed as a
+// two-lane vector. The scalar versions are the reference; the SIMD versions
+// perform the same operations in the same order.
+// -----------------------------------------------------------------------------
+
+typedef void (*RegrooveStereoKernel)(RegrooveEffects* fx, float* left, float* right, int frames);
+
+typedef struct {
+    const char* name;
+    RegrooveStereoKernel filter;
+    RegrooveStereoKernel eq;
+    RegrooveStereoKernel compressor;
+} RegrooveEffectsKernels;
+
+// Resonant low-pass: simple state-variable filter (Chamberlin)
+static void filter_kernel_scalar(RegrooveEffects* fx, float* left, float* right, int frames) {
+    const float f = fx->coef_filter_f;
+    const float q = fx->coef_filter_q;
+
+    for (int ch = 0; ch < 2; ch++) {
+        float* buf = (ch == 0) ? left : right;
+        float lp = fx->filter_lp[ch];
+        float bp = fx->filter_bp[ch];
+        for (int i = 0; i < frames; i++) {
+            lp += f * bp;
+            float hp = buf[i] - lp - q * bp;
+            bp += f * hp;
+            buf[i] = lp;
+        }
+        fx->filter_lp[ch] = lp;
+        fx->filter_bp[ch] = bp;
+    }
+}
+
+// 3-band EQ using stable cascaded filters
+// Low shelf (~250Hz), Mid band (~1kHz), High shelf (~6kHz)
+// Gain range: 0.5 = neutral, 0.0 = -12dB cut, 1.0 = +12dB boost
+static void eq_kernel_scalar(RegrooveEffects* fx, float* left, float* right, int frames) {
+    const float low_alpha = fx->coef_eq_low_alpha;
+    const float mid_alpha = fx->coef_eq_mid_alpha;
+    const float low_mult = fx->coef_eq_low_mult;
+    const float mid_gain = fx->coef_eq_mid_mult - 1.0f;
+    const float high_gain = fx->coef_eq_high_mult - 1.0f;
+
+    for (int ch = 0; ch < 2; ch++) {
+        float* buf = (ch == 0) ? left : right;
+        float lp1 = fx->eq_lp1[ch];
+        float lp2 = fx->eq_lp2[ch];
+        for (int i = 0; i < frames; i++) {
+            float sample = buf[i];
+
+            // Low shelf: one-pole lowpass filter for bass (below 250Hz)
+            lp1 += low_alpha * (sample - lp1);
+            float low_out = lp1 * low_mult + (sample - lp1);
+
+            // Mid band: bandpass (250Hz to 6kHz) - what's left after low and high
+            lp2 += mid_alpha * (low_out - lp2);
+            float mid_out = low_out + (lp2 - lp1) * mid_gain;
+
+            // High shelf: boost/cut high frequencies (above 6kHz)
+            buf[i] = mid_out + (mid_out - lp2) * high_gain;
+        }
+        fx->eq_lp1[ch] = lp1;
+        fx->eq_lp2[ch] = lp2;
+    }
+}
+
+// Compressor: RMS detection, attack/release envelope, soft knee, makeup gain
+static void compressor_kernel_scalar(RegrooveEffects* fx, float* left, float* right, int frames) {
+    const float attack_coeff = fx->coef_comp_attack;
+    const float release_coeff = fx->coef_comp_release;
+    const float threshold = fx->coef_comp_threshold;
+    const float ratio = fx->coef_comp_ratio;
+    const float makeup = fx->coef_comp_makeup;
+    const float rms_alpha = 0.01f;                    // Smoothing coefficient for RMS
+    const float knee_range = threshold * 0.1f;        // ±10% threshold soft knee
+
+    for (int ch = 0; ch < 2; ch++) {
+        float* buf = (ch == 0) ? left : right;
+        float rms = fx->compressor_rms[ch];
+        float envelope = fx->compressor_envelope[ch];
+        for (int i = 0; i < frames; i++) {
+            float input = buf[i];
+
+            // 1. Compute RMS level (smoother than peak for musical compression)
+            rms += rms_alpha * (input * input - rms);
+            float rms_level = sqrtf(fmaxf(rms, 0.0f));
+
+            // 2. Attack/release envelope follower
+            float coeff = (rms_level > envelope) ? attack_coeff : release_coeff;
+            envelope += coeff * (rms_level - envelope);
+
+            // 3. Gain computer with soft knee
+            float gain = 1.0f;
+            if (envelope > threshold) {
+                float delta = envelope - threshold;
+                float hard_gain = (threshold + delta / ratio) / envelope;
+                if (delta < knee_range) {
+                    // Soft knee: smooth polynomial transition
+                    float x = delta / knee_range;  // 0.0 to 1.0
+                    float curve = x * x * (3.0f - 2.0f * x);  // Smoothstep
+                    gain = 1.0f - curve * (1.0f - hard_gain);
+                } else {
+                    // Hard compression above knee
+                    gain = hard_gain;
+                }
+            }
+
+            // 4. Apply compression and makeup gain
+            buf[i] = input * gain * makeup;
+        }
+        fx->compressor_rms[ch] = rms;
+        fx->compressor_envelope[ch] = envelope;
+    }
+}
+
+static const RegrooveEffectsKernels kernels_scalar = {
+    "scalar", filter_kernel_scalar, eq_kernel_scalar, compressor_kernel_scalar
+};
+
+// SSE2 is the x86-64 baseline (and -msse2 on 32-bit x86), so the kernel set
+// is chosen at build time; there is no CPU without it to dispatch around.
+#if defined(__SSE2__)
+#define REGROOVE_EFFECTS_HAVE_SSE2 1
+#include <emmintrin.h>
+
+// SSE2: lanes 0/1 = L/R, lanes 2/3 unused
+
+static inline __m128 sse2_load_lr(const float* state) {
+    return _mm_setr_ps(state[0], state[1], 0.0f, 0.0f);
+}
+
+static inline void sse2_store_lr(float* state, __m128 v) {
+    float tmp[4];
+    _mm_storeu_ps(tmp, v);
+    state[0] = tmp[0];
+    state[1] = tmp[1];
+}
+
+static void filter_kernel_sse2(RegrooveEffects* fx, float* left, float* right, int frames) {
+    const __m128 f = _mm_set1_ps(fx->coef_filter_f);
+    const __m128 q = _mm_set1_ps(fx->coef_filter_q);
+    __m128 lp = sse2_load_lr(fx->filter_lp);
+    __m128 bp = sse2_load_lr(fx->filter_bp);
+    float out[4];
+
+    for (int i = 0; i < frames; i++) {
+        __m128 x = _mm_setr_ps(left[i], right[i], 0.0f, 0.0f);
+        lp = _mm_add_ps(lp, _mm_mul_ps(f, bp));
+        __m128 hp = _mm_sub_ps(_mm_sub_ps(x, lp), _mm_mul_ps(q, bp));
+        bp = _mm_add_ps(bp, _mm_mul_ps(f, hp));
+        _mm_storeu_ps(out, lp);
+        left[i] = out[0];
+        right[i] = out[1];
+    }
+
+    sse2_store_lr(fx->filter_lp, lp);
+    sse2_store_lr(fx->filter_bp, bp);
+}
+
+static void eq_kernel_sse2(RegrooveEffects* fx, float* left, float* right, int frames) {
+    const __m128 low_alpha = _mm_set1_ps(fx->coef_eq_low_alpha);
+    const __m128 mid_alpha = _mm_set1_ps(fx->coef_eq_mid_alpha);
+    const __m128 low_mult = _mm_set1_ps(fx->coef_eq_low_mult);
+    const __m128 mid_gain = _mm_set1_ps(fx->coef_eq_mid_mult - 1.0f);
+    const __m128 high_gain = _mm_set1_ps(fx->coef_eq_high_mult - 1.0f);
+    __m128 lp1 = sse2_load_lr(fx->eq_lp1);
+    __m128 lp2 = sse2_load_lr(fx->eq_lp2);
+    float out[4];
+
+    for (int i = 0; i < frames; i++) {
+        __m128 x = _mm_setr_ps(left[i], right[i], 0.0f, 0.0f);
+        lp1 = _mm_add_ps(lp1, _mm_mul_ps(low_alpha, _mm_sub_ps(x, lp1)));
+        __m128 low_out = _mm_add_ps(_mm_mul_ps(lp1, low_mult), _mm_sub_ps(x, lp1));
+        lp2 = _mm_add_ps(lp2, _mm_mul_ps(mid_alpha, _mm_sub_ps(low_out, lp2)));
+        __m128 mid_out = _mm_add_ps(low_out, _mm_mul_ps(_mm_sub_ps(lp2, lp1), mid_gain));
+        __m128 y = _mm_add_ps(mid_out, _mm_mul_ps(_mm_sub_ps(mid_out, lp2), high_gain));
+        _mm_storeu_ps(out, y);
+        left[i] = out[0];
+        right[i] = out[1];
+    }
+
+    sse2_store_lr(fx->eq_lp1, lp1);
+    sse2_store_lr(fx->eq_lp2, lp2);
+}
+
+static void compressor_kernel_sse2(RegrooveEffects* fx, float* left, float* right, int frames) {
+    const __m128 attack_coeff = _mm_set1_ps(fx->coef_comp_attack);
+    const __m128 release_coeff = _mm_set1_ps(fx->coef_comp_release);
+    const __m128 threshold = _mm_set1_ps(fx->coef_comp_threshold);
+    const __m128 ratio = _mm_set1_ps(fx->coef_comp_ratio);
+    const __m128 makeup = _mm_set1_ps(fx->coef_comp_makeup);
+    const __m128 rms_alpha = _mm_set1_ps(0.01f);
+    const __m128 knee_range = _mm_set1_ps(fx->coef_comp_threshold * 0.1f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 three = _mm_set1_ps(3.0f);
+    __m128 rms = sse2_load_lr(fx->compressor_rms);
+    __m128 envelope = sse2_load_lr(fx->compressor_envelope);
+    float out[4];
+
+    for (int i = 0; i < frames; i++) {
+        __m128 x = _mm_setr_ps(left[i], right[i], 0.0f, 0.0f);
+
+        rms = _mm_add_ps(rms, _mm_mul_ps(rms_alpha, _mm_sub_ps(_mm_mul_ps(x, x), rms)));
+        __m128 rms_level = _mm_sqrt_ps(_mm_max_ps(rms, zero));
+
+        __m128 rising = _mm_cmpgt_ps(rms_level, envelope);
+        __m128 coeff = _mm_or_ps(_mm_and_ps(rising, attack_coeff), _mm_andnot_ps(rising, release_coeff));
+        envelope = _mm_add_ps(envelope, _mm_mul_ps(coeff, _mm_sub_ps(rms_level, envelope)));
+
+        // Both knee branches are computed, then selected per lane
+        __m128 delta = _mm_sub_ps(envelope, threshold);
+        __m128 hard_gain = _mm_div_ps(_mm_add_ps(threshold, _mm_div_ps(delta, ratio)), envelope);
+        __m128 k = _mm_div_ps(delta, knee_range);
+        __m128 curve = _mm_mul_ps(_mm_mul_ps(k, k), _mm_sub_ps(three, _mm_mul_ps(two, k)));
+        __m128 soft_gain = _mm_sub_ps(one, _mm_mul_ps(curve, _mm_sub_ps(one, hard_gain)));
+        __m128 in_knee = _mm_cmplt_ps(delta, knee_range);
+        __m128 comp_gain = _mm_or_ps(_mm_and_ps(in_knee, soft_gain), _mm_andnot_ps(in_knee, hard_gain));
+        __m128 above = _mm_cmpgt_ps(envelope, threshold);
+        __m128 gain = _mm_or_ps(_mm_and_ps(above, comp_gain), _mm_andnot_ps(above, one));
+
+        __m128 y = _mm_mul_ps(_mm_mul_ps(x, gain), makeup);
+        _mm_storeu_ps(out, y);
+        left[i] = out[0];
+        right[i] = out[1];
+    }
+
+    sse2_store_lr(fx->compressor_rms, rms);
+    sse2_store_lr(fx->compressor_envelope, envelope);
+}
+
+static const RegrooveEffectsKernels kernels_sse2 = {
+    "sse2", filter_kernel_sse2, eq_kernel_sse2, compressor_kernel_sse2
+};
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define REGROOVE_EFFECTS_HAVE_NEON 1
+#include <arm_neon.h>
+
+// NEON (AArch64): one float32x2_t holds L/R exactly
+
+static void filter_kernel_neon(RegrooveEffects* fx, float* left, float* right, int frames) {
+    const float32x2_t f = vdup_n_f32(fx->coef_filter_f);
+    const float32x2_t q = vdup_n_f32(fx->coef_filter_q);
+    float32x2_t lp = vld1_f32(fx->filter_lp);
+    float32x2_t bp = vld1_f32(fx->filter_bp);
+
+    for (int i = 0; i < frames; i++) {
+        float32x2_t x = vset_lane_f32(right[i], vdup_n_f32(left[i]), 1);
+        lp = vadd_f32(lp, vmul_f32(f, bp));
+        float32x2_t hp = vsub_f32(vsub_f32(x, lp), vmul_f32(q, bp));
+        bp = vadd_f32(bp, vmul_f32(f, hp));
+        left[i] = vget_lane_f32(lp, 0);
+        right[i] = vget_lane_f32(lp, 1);
+    }
+
+    vst1_f32(fx->filter_lp, lp);
+    vst1_f32(fx->filter_bp, bp);
+}
+
+static void eq_kernel_neon(RegrooveEffects* fx, float* left, float* right, int frames) {
+    const float32x2_t low_alpha = vdup_n_f32(fx->coef_eq_low_alpha);
+    const float32x2_t mid_alpha = vdup_n_f32(fx->coef_eq_mid_alpha);
+    const float32x2_t low_mult = vdup_n_f32(fx->coef_eq_low_mult);
+    const float32x2_t mid_gain = vdup_n_f32(fx->coef_eq_mid_mult - 1.0f);
+    const float32x2_t high_gain = vdup_n_f32(fx->coef_eq_high_mult - 1.0f);
+    float32x2_t lp1 = vld1_f32(fx->eq_lp1);
+    float32x2_t lp2 = vld1_f32(fx->eq_lp2);
+
+    for (int i = 0; i < frames; i++) {
+        float32x2_t x = vset_lane_f32(right[i], vdup_n_f32(left[i]), 1);
+        lp1 = vadd_f32(lp1, vmul_f32(low_alpha, vsub_f32(x, lp1)));
+        float32x2_t low_out = vadd_f32(vmul_f32(lp1, low_mult), vsub_f32(x, lp1));
+        lp2 = vadd_f32(lp2, vmul_f32(mid_alpha, vsub_f32(low_out, lp2)));
+        float32x2_t mid_out = vadd_f32(low_out, vmul_f32(vsub_f32(lp2, lp1), mid_gain));
+        float32x2_t y = vadd_f32(mid_out, vmul_f32(vsub_f32(mid_out, lp2), high_gain));
+        left[i] = vget_lane_f32(y, 0);
+        right[i] = vget_lane_f32(y, 1);
+    }
+
+    vst1_f32(fx->eq_lp1, lp1);
+    vst1_f32(fx->eq_lp2, lp2);
+}
+
+static void compressor_kernel_neon(RegrooveEffects* fx, float* left, float* right, int frames) {
+    const float32x2_t attack_coeff = vdup_n_f32(fx->coef_comp_attack);
+    const float32x2_t release_coeff = vdup_n_f32(fx->coef_comp_release);
+    const float32x2_t threshold = vdup_n_f32(fx->coef_comp_threshold);
+    const float32x2_t ratio = vdup_n_f32(fx->coef_comp_ratio);
+    const float32x2_t makeup = vdup_n_f32(fx->coef_comp_makeup);
+    const float32x2_t rms_alpha = vdup_n_f32(0.01f);
+    const float32x2_t knee_range = vdup_n_f32(fx->coef_comp_threshold * 0.1f);
+    const float32x2_t zero = vdup_n_f32(0.0f);
+    const float32x2_t one = vdup_n_f32(1.0f);
+    const float32x2_t two = vdup_n_f32(2.0f);
+    const float32x2_t three = vdup_n_f32(3.0f);
+    float32x2_t rms = vld1_f32(fx->compressor_rms);
+    float32x2_t envelope = vld1_f32(fx->compressor_envelope);
+
+    for (int i = 0; i < frames; i++) {
+        float32x2_t x = vset_lane_f32(right[i], vdup_n_f32(left[i]), 1);
+
+        rms = vadd_f32(rms, vmul_f32(rms_alpha, vsub_f32(vmul_f32(x, x), rms)));
+        float32x2_t rms_level = vsqrt_f32(vmax_f32(rms, zero));
+
+        uint32x2_t rising = vcgt_f32(rms_level, envelope);
+        float32x2_t coeff = vbsl_f32(rising, attack_coeff, release_coeff);
+        envelope = vadd_f32(envelope, vmul_f32(coeff, vsub_f32(rms_level, envelope)));
+
+        // Both knee branches are computed, then selected per lane
+        float32x2_t delta = vsub_f32(envelope, threshold);
+        float32x2_t hard_gain = vdiv_f32(vadd_f32(threshold, vdiv_f32(delta, ratio)), envelope);
+        float32x2_t k = vdiv_f32(delta, knee_range);
+        float32x2_t curve = vmul_f32(vmul_f32(k, k), vsub_f32(three, vmul_f32(two, k)));
+        float32x2_t soft_gain = vsub_f32(one, vmul_f32(curve, vsub_f32(one, hard_gain)));
+        float32x2_t comp_gain = vbsl_f32(vclt_f32(delta, knee_range), soft_gain, hard_gain);
+        float32x2_t gain = vbsl_f32(vcgt_f32(envelope, threshold), comp_gain, one);
+
+        float32x2_t y = vmul_f32(vmul_f32(x, gain), makeup);
+        left[i] = vget_lane_f32(y, 0);
+        right[i] = vget_lane_f32(y, 1);
+    }
+
+    vst1_f32(fx->compressor_rms, rms);
+    vst1_f32(fx->compressor_envelope, envelope);
+}
+
+static const RegrooveEffectsKernels kernels_neon = {
+    "neon", filter_kernel_neon, eq_kernel_neon, compressor_kernel_neon
+};
+#endif
+
+// Selected once (from regroove_effects_create, off the audio thread)
+static const RegrooveEffectsKernels* active_kernels = NULL;
+
+static const RegrooveEffectsKernels* regroove_effects_select_kernels(void) {
+    if (active_kernels) return active_kernels;
+
+    // REGROOVE_FX_SCALAR=1 forces the reference path (for A/B checks)
+    const char* force_scalar = getenv("REGROOVE_FX_SCALAR");
+    if (force_scalar && force_scalar[0] == '1') {
+        active_kernels = &kernels_scalar;
+        return active_kernels;
+    }
+
+#if defined(REGROOVE_EFFECTS_HAVE_SSE2)
+    active_kernels = &kernels_sse2;
+    return active_kernels;
+#elif defined(REGROOVE_EFFECTS_HAVE_NEON)
+    active_kernels = &kernels_neon;
+    return active_kernels;
+#endif
+
+    active_kernels = &kernels_scalar;
+    return active_kernels;
+}
+
+const char* regroove_effects_get_simd_name(void) {
+    return regroove_effects_select_kernels()->name;
+}
+
 RegrooveEffects* regroove_effects_create(void) {
     RegrooveEffects* fx = (RegrooveEffects*)calloc(1, sizeof(RegrooveEffects));
     if (!fx) return NULL;
 
-    // Allocate delay buffers
-    fx->delay_buffer[0] = (float*)calloc(MAX_DELAY_SAMPLES, sizeof(float));
-    fx->delay_buffer[1] = (float*)calloc(MAX_DELAY_SAMPLES, sizeof(float));
-    if (!fx->delay_buffer[0] || !fx->delay_buffer[1]) {
-        free(fx->delay_buffer[0]);
-        free(fx->delay_buffer[1]);
-        free(fx);
-        return NULL;
+    regroove_effects_select_kernels();
+
+    // Reverb line layout (one block, lines back to back). The delay and
+    // reverb buffers themselves are allocated on first enable.
+    int reverb_total = 0;
+    for (int k = 0; k < REVERB_FDN_LINES; k++) {
+        fx->reverb_offset[k] = reverb_total;
+        fx->reverb_length[k] = reverb_base_lengths[k];
+        reverb_total += reverb_base_lengths[k];
     }
 
     // Default parameters
@@ -107,17 +693,54 @@ RegrooveEffects* regroove_effects_create(void) {
     fx->delay_feedback = 0.4f;
     fx->delay_mix = 0.3f;
 
+    // Start smoothed values at the defaults (no initial ramp);
+    // coefficients are derived on the first processed block
+    regroove_effects_snap_params(fx);
+    fx->coeffs_dirty = 1;
+    fx->coeffs_sample_rate = 0;
+
     return fx;
 }
 
 void regroove_effects_destroy(RegrooveEffects* fx) {
     if (fx) {
-        free(fx->delay_buffer[0]);
-        free(fx->delay_buffer[1]);
+        free(fx->delay_buffer[0]);  // L and R share one allocation
+        free(fx->reverb_buffer);
         free(fx);
     }
 }
 
+// Allocate the delay lines (L and R in one block) if not done yet
+static int regroove_effects_alloc_delay(RegrooveEffects* fx) {
+    if (acquire_buffer(&fx->delay_buffer[1])) return 1;
+
+    float *block = (float*)calloc(2 * MAX_DELAY_SAMPLES, sizeof(float));
+    if (!block) return 0;
+
+    if (!publish_buffer(&fx->delay_buffer[0], block)) {
+        // Another thread got there first
+        free(block);
+        return acquire_buffer(&fx->delay_buffer[1]) != NULL;
+    }
+    // Audio thread requires both pointers, R is published last
+    publish_buffer(&fx->delay_buffer[1], block + MAX_DELAY_SAMPLES);
+    return 1;
+}
+
+// Allocate the reverb lines if not done yet
+static int regroove_effects_alloc_reverb(RegrooveEffects* fx) {
+    if (acquire_buffer(&fx->reverb_buffer)) return 1;
+
+    int reverb_total = fx->reverb_offset[REVERB_FDN_LINES - 1] + reverb_base_lengths[REVERB_FDN_LINES - 1];
+    float *block = (float*)calloc(reverb_total, sizeof(float));
+    if (!block) return 0;
+
+    if (!publish_buffer(&fx->reverb_buffer, block)) {
+        free(block);
+    }
+    return 1;
+}
+
 void regroove_effects_reset(RegrooveEffects* fx) {
     if (!fx) return;
 
@@ -144,6 +767,19 @@ void regroove_effects_reset(RegrooveEffects* fx) {
     memset(fx->compressor_envelope, 0, sizeof(fx->compressor_envelope));
     memset(fx->compressor_rms, 0, sizeof(fx->compressor_rms));
 
+    // Clear phaser state
+    memset(fx->phaser_ap, 0, sizeof(fx->phaser_ap));
+    memset(fx->phaser_fb, 0, sizeof(fx->phaser_fb));
+    fx->phaser_lfo_phase = 0.0f;
+
+    // Clear reverb lines and damping state
+    if (fx->reverb_buffer) {
+        int reverb_total = fx->reverb_offset[REVERB_FDN_LINES - 1] + reverb_base_lengths[REVERB_FDN_LINES - 1];
+        memset(fx->reverb_buffer, 0, reverb_total * sizeof(float));
+    }
+    memset(fx->reverb_pos, 0, sizeof(fx->reverb_pos));
+    memset(fx->reverb_damp, 0, sizeof(fx->reverb_damp));
+
     // Clear delay buffers and reset write position
     if (fx->delay_buffer[0]) {
         memset(fx->delay_buffer[0], 0, MAX_DELAY_SAMPLES * sizeof(float));
@@ -154,36 +790,138 @@ void regroove_effects_reset(RegrooveEffects* fx) {
     fx->delay_write_pos = 0;
 }
 
-void regroove_effects_process(RegrooveEffects* fx, int16_t* buffer, int frames, int sample_rate) {
-    if (!fx || !buffer || frames <= 0) return;
+// Phaser: 4 all-pass stages swept by a sine LFO (R lags L by 90 degrees),
+// with feedback from the last stage; coefficients refresh every
+// PHASER_CONTROL_RATE samples instead of per sample
+static void phaser_process(RegrooveEffects* fx, float* left, float* right, int frames, int sample_rate) {
+    const float sr = (float)sample_rate;
+    const float min_freq = fx->coef_phaser_min_freq;
+    const float sweep = fx->coef_phaser_sweep;
+    const float feedback = fx->coef_phaser_feedback;
+    const float lfo_inc = fx->coef_phaser_lfo_inc;
+
+    for (int start = 0; start < frames; start += PHASER_CONTROL_RATE) {
+        int count = frames - start;
+        if (count > PHASER_CONTROL_RATE) count = PHASER_CONTROL_RATE;
+
+        // LFO 0..1 per channel -> all-pass coefficient
+        float phase = fx->phaser_lfo_phase * 2.0f * 3.14159265f;
+        float lfo_l = 0.5f + 0.5f * sinf(phase);
+        float lfo_r = 0.5f + 0.5f * cosf(phase);
+        float a_ch[2];
+        a_ch[0] = allpass_coeff(min_freq * (1.0f + sweep * lfo_l), sr);
+        a_ch[1] = allpass_coeff(min_freq * (1.0f + sweep * lfo_r), sr);
+
+        for (int ch = 0; ch < 2; ch++) {
+            float* buf = ((ch == 0) ? left : right) + start;
+            float a = a_ch[ch];
+            float fb = fx->phaser_fb[ch];
+            for (int i = 0; i < count; i++) {
+                float x = buf[i];
+                float y = x + fb * feedback;
+                for (int stage = 0; stage < 4; stage++) {
+                    y = allpass_tick(y, &fx->phaser_ap[stage][ch], a);
+                }
+                fb = y;
+                // Dry + all-passed signal produces the moving notches
+                buf[i] = (x + y) * 0.5f;
+            }
+            fx->phaser_fb[ch] = fb;
+        }
 
-    // Convert to float for processing
-    const float scale_to_float = 1.0f / 32768.0f;
-    const float scale_to_int16 = 32767.0f;
+        fx->phaser_lfo_phase += lfo_inc * count;
+        if (fx->phaser_lfo_phase >= 1.0f) fx->phaser_lfo_phase -= 1.0f;
+    }
+}
+
+// Reverb: 8-line feedback delay network with a Hadamard mixing matrix,
+// per-line decay gain and damping lowpass. L feeds the even lines and R the
+// odd lines; the wet output is taken from the same split.
+static void reverb_process(RegrooveEffects* fx, const RegrooveEffectsParams* params,
+                           float* left, float* right, int frames) {
+    const float damp = fx->coef_reverb_damp;
+    const float mix = params->reverb_mix;
+    const float hadamard_scale = 0.35355339f;  // 1/sqrt(8), keeps the matrix lossless
+    float* lines[REVERB_FDN_LINES];
+    for (int k = 0; k < REVERB_FDN_LINES; k++) {
+        lines[k] = fx->reverb_buffer + fx->reverb_offset[k];
+    }
 
     for (int i = 0; i < frames; i++) {
-        // Get stereo samples
-        float left = (float)buffer[i * 2] * scale_to_float;
-        float right = (float)buffer[i * 2 + 1] * scale_to_float;
+        float in_l = left[i];
+        float in_r = right[i];
+        float v[REVERB_FDN_LINES];
+
+        // Read line outputs, apply decay and damping
+        for (int k = 0; k < REVERB_FDN_LINES; k++) {
+            float out = lines[k][fx->reverb_pos[k]] * fx->coef_reverb_gain[k];
+            fx->reverb_damp[k] = out + damp * (fx->reverb_damp[k] - out);
+            v[k] = fx->reverb_damp[k];
+        }
+
+        float wet_l = (v[0] + v[2] + v[4] + v[6]) * 0.5f;
+        float wet_r = (v[1] + v[3] + v[5] + v[7]) * 0.5f;
+
+        // Fast Walsh-Hadamard transform (8 points, in place)
+        for (int len = 1; len < REVERB_FDN_LINES; len <<= 1) {
+            for (int j = 0; j < REVERB_FDN_LINES; j += len << 1) {
+                for (int k = j; k < j + len; k++) {
+                    float a = v[k];
+                    float b = v[k + len];
+                    v[k] = a + b;
+                    v[k + len] = a - b;
+                }
+            }
+        }
+
+        // Write back mixed feedback plus input, advance positions
+        for (int k = 0; k < REVERB_FDN_LINES; k++) {
+            float input = (k & 1) ? in_r : in_l;
+            lines[k][fx->reverb_pos[k]] = v[k] * hadamard_scale + input * 0.25f;
+            if (++fx->reverb_pos[k] >= fx->reverb_length[k]) fx->reverb_pos[k] = 0;
+        }
+
+        left[i] = in_l * (1.0f - mix) + wet_l * mix;
+        right[i] = in_r * (1.0f - mix) + wet_r * mix;
+    }
+}
+
+void regroove_effects_process_f32(RegrooveEffects* fx, float* left_buf, float* right_buf, int frames, int sample_rate) {
+    if (!fx || !left_buf || !right_buf || frames <= 0 || sample_rate <= 0) return;
+
+    // Ramp parameters toward their targets and refresh derived
+    // coefficients once per block (not per sample)
+    int moving = regroove_effects_smooth_params(fx, frames, sample_rate);
+    if (moving || fx->coeffs_dirty || fx->coeffs_sample_rate != sample_rate) {
+        regroove_effects_update_coeffs(fx, sample_rate);
+    }
+    const RegrooveEffectsParams* params = &fx->smoothed;
+
+    // Each stage runs over the whole block in chain order
+    const RegrooveEffectsKernels* kernels = regroove_effects_select_kernels();
+
+    // --- DISTORTION (RB338-style aggressive overdrive for 909 kicks) ---
+    if (fx->distortion_enabled) {
+        for (int i = 0; i < frames; i++) {
+            float left = left_buf[i];
+            float right = right_buf[i];
 
-        // --- DISTORTION (RB338-style aggressive overdrive for 909 kicks) ---
-        if (fx->distortion_enabled) {
             float dry_left = left;
             float dry_right = right;
 
             // Pre-emphasis EQ chain:
             // 1. Highpass at 80Hz to remove sub-rumble
-            float hp_cutoff = 80.0f / sample_rate;
-            float emphasized_left = highpass_tick(left, &fx->distortion_hp[0], hp_cutoff);
-            float emphasized_right = highpass_tick(right, &fx->distortion_hp[1], hp_cutoff);
+            float hp_alpha = fx->coef_distortion_hp_alpha;
+            float emphasized_left = highpass_tick(left, &fx->distortion_hp[0], hp_alpha);
+            float emphasized_right = highpass_tick(right, &fx->distortion_hp[1], hp_alpha);
 
             // 2. Add resonant bandpass bump at 120Hz for punch (909 kick fundamental)
-            float bp_freq = 120.0f / sample_rate;
+            float bp_f = fx->coef_distortion_bp_f;
             float bp_q = 0.5f;  // Resonance for punch
             float bp_left = bandpass_bump(emphasized_left, &fx->distortion_bp_lp[0],
-                                         &fx->distortion_bp_bp[0], bp_freq, bp_q);
+                                         &fx->distortion_bp_bp[0], bp_f, bp_q);
             float bp_right = bandpass_bump(emphasized_right, &fx->distortion_bp_lp[1],
-                                          &fx->distortion_bp_bp[1], bp_freq, bp_q);
+                                          &fx->distortion_bp_bp[1], bp_f, bp_q);
 
             // Mix in the punch bump
             emphasized_left += bp_left * 0.5f;
@@ -196,8 +934,7 @@ void regroove_effects_process(RegrooveEffects* fx, int16_t* buffer, int frames,
             float env_r = envelope_follower(emphasized_right, &fx->distortion_env[1], attack_coeff, release_coeff);
 
             // Dynamic drive: more aggressive on transients (kicks, snares)
-            // Drive amount: 0.0 = 1x, 1.0 = 8x
-            float base_drive = 1.0f + fx->distortion_drive * 7.0f;
+            float base_drive = fx->coef_distortion_drive;
             float dynamic_drive_l = base_drive * (0.7f + env_l * 0.6f);
             float dynamic_drive_r = base_drive * (0.7f + env_r * 0.6f);
 
@@ -213,8 +950,7 @@ void regroove_effects_process(RegrooveEffects* fx, int16_t* buffer, int frames,
             float shaped_right = rb338_shaper(folded_right);
 
             // Post-EQ: lowpass at 8kHz to tame harshness, add warmth
-            float lp_cutoff = 8000.0f / sample_rate;
-            float lp_alpha = 1.0f - expf(-2.0f * 3.14159f * lp_cutoff);
+            float lp_alpha = fx->coef_distortion_lp_alpha;
             fx->distortion_lp[0] += lp_alpha * (shaped_left - fx->distortion_lp[0]);
             fx->distortion_lp[1] += lp_alpha * (shaped_right - fx->distortion_lp[1]);
 
@@ -222,168 +958,96 @@ void regroove_effects_process(RegrooveEffects* fx, int16_t* buffer, int frames,
             float wet_right = fx->distortion_lp[1];
 
             // Mix dry/wet
-            left = dry_left * (1.0f - fx->distortion_mix) + wet_left * fx->distortion_mix;
-            right = dry_right * (1.0f - fx->distortion_mix) + wet_right * fx->distortion_mix;
-        }
+            left = dry_left * (1.0f - params->distortion_mix) + wet_left * params->distortion_mix;
+            right = dry_right * (1.0f - params->distortion_mix) + wet_right * params->distortion_mix;
 
-        // --- RESONANT LOW-PASS FILTER ---
-        if (fx->filter_enabled) {
-            // Simple state-variable filter (Chamberlin)
-            // Normalized cutoff to actual frequency (linear mapping)
-            float nyquist = sample_rate * 0.5f;
-            float freq = fx->filter_cutoff * nyquist * 0.48f; // Linear for predictable response
-            float f = 2.0f * sinf(3.14159265f * freq / (float)sample_rate);
-
-            // Resonance (Q) - limit range for stability
-            // 0.0 resonance = q of 0.7 (gentle)
-            // 1.0 resonance = q of 0.1 (strong but stable)
-            float q = 0.7f - fx->filter_resonance * 0.6f;
-            if (q < 0.1f) q = 0.1f;
-
-            // Process left channel
-            fx->filter_lp[0] += f * fx->filter_bp[0];
-            float hp = left - fx->filter_lp[0] - q * fx->filter_bp[0];
-            fx->filter_bp[0] += f * hp;
-            left = fx->filter_lp[0];
-
-            // Process right channel
-            fx->filter_lp[1] += f * fx->filter_bp[1];
-            hp = right - fx->filter_lp[1] - q * fx->filter_bp[1];
-            fx->filter_bp[1] += f * hp;
-            right = fx->filter_lp[1];
+            left_buf[i] = left;
+            right_buf[i] = right;
         }
+    }
 
-        // --- 3-BAND EQ ---
-        if (fx->eq_enabled) {
-            // 3-band EQ using stable cascaded filters
-            // Low shelf (~250Hz), Mid band (~1kHz), High shelf (~6kHz)
-            // Gain range: 0.5 = neutral, 0.0 = -12dB cut, 1.0 = +12dB boost
-            float low_gain = fx->eq_low;   // 0.0 to 1.0
-            float mid_gain = fx->eq_mid;   // 0.0 to 1.0
-            float high_gain = fx->eq_high; // 0.0 to 1.0
-
-            // Convert to linear gain (0.25x to 4x, with 1.0x at 0.5)
-            float low_mult = powf(4.0f, (low_gain - 0.5f) * 2.0f);   // 0.25 to 4.0
-            float mid_mult = powf(4.0f, (mid_gain - 0.5f) * 2.0f);
-            float high_mult = powf(4.0f, (high_gain - 0.5f) * 2.0f);
-
-            for (int ch = 0; ch < 2; ch++) {
-                float sample = (ch == 0) ? left : right;
-
-                // Low shelf: one-pole lowpass filter for bass (below 250Hz)
-                float low_freq = 250.0f / sample_rate;
-                float low_alpha = 1.0f - expf(-2.0f * 3.14159f * low_freq);
-                fx->eq_lp1[ch] += low_alpha * (sample - fx->eq_lp1[ch]);
-                float low_out = fx->eq_lp1[ch] * low_mult + (sample - fx->eq_lp1[ch]);
-
-                // Mid band: bandpass (250Hz to 6kHz) - what's left after low and high
-                float mid_freq = 6000.0f / sample_rate;
-                float mid_alpha = 1.0f - expf(-2.0f * 3.14159f * mid_freq);
-                fx->eq_lp2[ch] += mid_alpha * (low_out - fx->eq_lp2[ch]);
-                float mid_band = fx->eq_lp2[ch] - fx->eq_lp1[ch];
-                float mid_out = low_out + mid_band * (mid_mult - 1.0f);
-
-                // High shelf: boost/cut high frequencies (above 6kHz)
-                float high_band = mid_out - fx->eq_lp2[ch];
-                float final_out = mid_out + high_band * (high_mult - 1.0f);
-
-                if (ch == 0) left = final_out;
-                else right = final_out;
-            }
-        }
-
-        // --- COMPRESSOR (Professional RMS with soft knee and makeup gain) ---
-        if (fx->compressor_enabled) {
-            for (int ch = 0; ch < 2; ch++) {
-                float input = (ch == 0) ? left : right;
-
-                // 1. Compute RMS level (smoother than peak for musical compression)
-                float squared = input * input;
-                float rms_alpha = 0.01f;  // Smoothing coefficient for RMS
-                fx->compressor_rms[ch] += rms_alpha * (squared - fx->compressor_rms[ch]);
-                float rms_level = sqrtf(fmaxf(fx->compressor_rms[ch], 0.0f));
-
-                // 2. Attack/release envelope follower
-                // Attack: 0.5ms to 50ms (0.0-1.0 maps to fast to slow)
-                // Release: 10ms to 500ms (0.0-1.0 maps to fast to slow)
-                float attack_time = 0.0005f + fx->compressor_attack * 0.0495f;
-                float release_time = 0.01f + fx->compressor_release * 0.49f;
-                float attack_coeff = 1.0f - expf(-1.0f / (sample_rate * attack_time));
-                float release_coeff = 1.0f - expf(-1.0f / (sample_rate * release_time));
-
-                if (rms_level > fx->compressor_envelope[ch]) {
-                    fx->compressor_envelope[ch] += attack_coeff * (rms_level - fx->compressor_envelope[ch]);
-                } else {
-                    fx->compressor_envelope[ch] += release_coeff * (rms_level - fx->compressor_envelope[ch]);
-                }
-
-                // 3. Threshold (0.0-1.0 maps to -40dB to -6dB, linear domain: 0.01 to 0.5)
-                float threshold = 0.01f + fx->compressor_threshold * 0.49f;
-
-                // 4. Ratio (0.0-1.0 maps to 1:1 to 20:1)
-                float ratio = 1.0f + fx->compressor_ratio * 19.0f;
-
-                // 5. Soft knee (0.1 = ±10% threshold for smooth transition)
-                float knee_width = 0.1f;
-                float gain = 1.0f;
-                float envelope = fx->compressor_envelope[ch];
-
-                if (envelope > threshold) {
-                    float delta = envelope - threshold;
-                    float knee_range = threshold * knee_width;
-
-                    if (delta < knee_range) {
-                        // Soft knee: smooth polynomial transition
-                        float x = delta / knee_range;  // 0.0 to 1.0
-                        float curve = x * x * (3.0f - 2.0f * x);  // Smoothstep
-                        float hard_gain = (threshold + delta / ratio) / envelope;
-                        gain = 1.0f - curve * (1.0f - hard_gain);
-                    } else {
-                        // Hard compression above knee
-                        gain = (threshold + delta / ratio) / envelope;
-                    }
-                }
+    // --- RESONANT LOW-PASS FILTER ---
+    if (fx->filter_enabled) {
+        kernels->filter(fx, left_buf, right_buf, frames);
+    }
 
-                // 6. Makeup gain (0.0-1.0 maps to 1x to 8x, compensates for level loss)
-                // At 0.5 (neutral), makeup is 1x. At 1.0, makeup is 8x.
-                float makeup = powf(8.0f, (fx->compressor_makeup - 0.5f) * 2.0f);
+    // --- 3-BAND EQ ---
+    if (fx->eq_enabled) {
+        kernels->eq(fx, left_buf, right_buf, frames);
+    }
 
-                // 7. Apply compression and makeup gain
-                float compressed = input * gain * makeup;
+    // --- COMPRESSOR (Professional RMS with soft knee and makeup gain) ---
+    if (fx->compressor_enabled) {
+        kernels->compressor(fx, left_buf, right_buf, frames);
+    }
 
-                if (ch == 0) left = compressed;
-                else right = compressed;
-            }
-        }
+    // --- PHASER ---
+    if (fx->phaser_enabled) {
+        phaser_process(fx, left_buf, right_buf, frames, sample_rate);
+    }
 
-        // --- DELAY/ECHO ---
-        if (fx->delay_enabled && fx->delay_buffer[0] && fx->delay_buffer[1]) {
-            // Delay time in samples (0-1000ms)
-            int delay_samples = (int)(fx->delay_time * sample_rate);
-            if (delay_samples > MAX_DELAY_SAMPLES - 1) delay_samples = MAX_DELAY_SAMPLES - 1;
+    // --- DELAY/ECHO ---
+    if (fx->delay_enabled && acquire_buffer(&fx->delay_buffer[1])) {
+        for (int i = 0; i < frames; i++) {
+            float left = left_buf[i];
+            float right = right_buf[i];
 
             // Read from delay buffer
-            int read_pos = fx->delay_write_pos - delay_samples;
+            int read_pos = fx->delay_write_pos - fx->coef_delay_samples;
             if (read_pos < 0) read_pos += MAX_DELAY_SAMPLES;
 
             float delayed_left = fx->delay_buffer[0][read_pos];
             float delayed_right = fx->delay_buffer[1][read_pos];
 
             // Write to delay buffer (input + feedback)
-            fx->delay_buffer[0][fx->delay_write_pos] = left + delayed_left * fx->delay_feedback;
-            fx->delay_buffer[1][fx->delay_write_pos] = right + delayed_right * fx->delay_feedback;
+            fx->delay_buffer[0][fx->delay_write_pos] = left + delayed_left * params->delay_feedback;
+            fx->delay_buffer[1][fx->delay_write_pos] = right + delayed_right * params->delay_feedback;
 
             // Mix dry/wet
-            left = left * (1.0f - fx->delay_mix) + delayed_left * fx->delay_mix;
-            right = right * (1.0f - fx->delay_mix) + delayed_right * fx->delay_mix;
+            left = left * (1.0f - params->delay_mix) + delayed_left * params->delay_mix;
+            right = right * (1.0f - params->delay_mix) + delayed_right * params->delay_mix;
 
             // Advance write position
             fx->delay_write_pos = (fx->delay_write_pos + 1) % MAX_DELAY_SAMPLES;
+
+            left_buf[i] = left;
+            right_buf[i] = right;
         }
+    }
+
+    // --- REVERB ---
+    if (fx->reverb_enabled && acquire_buffer(&fx->reverb_buffer)) {
+        reverb_process(fx, params, left_buf, right_buf, frames);
+    }
+}
+
+void regroove_effects_process(RegrooveEffects* fx, int16_t* buffer, int frames, int sample_rate) {
+    if (!fx || !buffer || frames <= 0) return;
+
+    const float scale_to_float = 1.0f / 32768.0f;
+    const float scale_to_int16 = 32767.0f;
+
+    // Deinterleave into small stack chunks so the float path does the work
+    float left[REGROOVE_EFFECTS_CHUNK_FRAMES];
+    float right[REGROOVE_EFFECTS_CHUNK_FRAMES];
+
+    for (int offset = 0; offset < frames; offset += REGROOVE_EFFECTS_CHUNK_FRAMES) {
+        int count = frames - offset;
+        if (count > REGROOVE_EFFECTS_CHUNK_FRAMES) count = REGROOVE_EFFECTS_CHUNK_FRAMES;
+
+        int16_t* chunk = buffer + offset * 2;
+        for (int i = 0; i < count; i++) {
+            left[i] = (float)chunk[i * 2] * scale_to_float;
+            right[i] = (float)chunk[i * 2 + 1] * scale_to_float;
+        }
+
+        regroove_effects_process_f32(fx, left, right, count, sample_rate);
 
         // Convert back to int16 with clamping
-        buffer[i * 2] = (int16_t)clampf(left * scale_to_int16, -32768.0f, 32767.0f);
-        buffer[i * 2 + 1] = (int16_t)clampf(right * scale_to_int16, -32768.0f, 32767.0f);
+        for (int i = 0; i < count; i++) {
+            chunk[i * 2] = (int16_t)clampf(left[i] * scale_to_int16, -32768.0f, 32767.0f);
+            chunk[i * 2 + 1] = (int16_t)clampf(right[i] * scale_to_int16, -32768.0f, 32767.0f);
+        }
     }
 }
 
@@ -395,12 +1059,12 @@ void regroove_effects_set_distortion_enabled(RegrooveEffects* fx, int enabled) {
 void regroove_effects_set_distortion_drive(RegrooveEffects* fx, float drive) {
     if (fx) {
         // Store normalized 0.0-1.0 directly
-        fx->distortion_drive = clampf(drive, 0.0f, 1.0f);
+        store_param(&fx->distortion_drive, clampf(drive, 0.0f, 1.0f));
     }
 }
 
 void regroove_effects_set_distortion_mix(RegrooveEffects* fx, float mix) {
-    if (fx) fx->distortion_mix = clampf(mix, 0.0f, 1.0f);
+    if (fx) store_param(&fx->distortion_mix, clampf(mix, 0.0f, 1.0f));
 }
 
 void regroove_effects_set_filter_enabled(RegrooveEffects* fx, int enabled) {
@@ -408,11 +1072,11 @@ void regroove_effects_set_filter_enabled(RegrooveEffects* fx, int enabled) {
 }
 
 void regroove_effects_set_filter_cutoff(RegrooveEffects* fx, float cutoff) {
-    if (fx) fx->filter_cutoff = clampf(cutoff, 0.0f, 1.0f);
+    if (fx) store_param(&fx->filter_cutoff, clampf(cutoff, 0.0f, 1.0f));
 }
 
 void regroove_effects_set_filter_resonance(RegrooveEffects* fx, float resonance) {
-    if (fx) fx->filter_resonance = clampf(resonance, 0.0f, 1.0f);
+    if (fx) store_param(&fx->filter_resonance, clampf(resonance, 0.0f, 1.0f));
 }
 
 // Parameter getters
@@ -421,11 +1085,11 @@ int regroove_effects_get_distortion_enabled(RegrooveEffects* fx) {
 }
 
 float regroove_effects_get_distortion_drive(RegrooveEffects* fx) {
-    return fx ? fx->distortion_drive : 0.0f;
+    return fx ? load_param(&fx->distortion_drive) : 0.0f;
 }
 
 float regroove_effects_get_distortion_mix(RegrooveEffects* fx) {
-    return fx ? fx->distortion_mix : 0.0f;
+    return fx ? load_param(&fx->distortion_mix) : 0.0f;
 }
 
 int regroove_effects_get_filter_enabled(RegrooveEffects* fx) {
@@ -433,11 +1097,11 @@ int regroove_effects_get_filter_enabled(RegrooveEffects* fx) {
 }
 
 float regroove_effects_get_filter_cutoff(RegrooveEffects* fx) {
-    return fx ? fx->filter_cutoff : 0.0f;
+    return fx ? load_param(&fx->filter_cutoff) : 0.0f;
 }
 
 float regroove_effects_get_filter_resonance(RegrooveEffects* fx) {
-    return fx ? fx->filter_resonance : 0.0f;
+    return fx ? load_param(&fx->filter_resonance) : 0.0f;
 }
 
 // EQ setters/getters
@@ -445,25 +1109,25 @@ void regroove_effects_set_eq_enabled(RegrooveEffects* fx, int enabled) {
     if (fx) fx->eq_enabled = enabled;
 }
 void regroove_effects_set_eq_low(RegrooveEffects* fx, float gain) {
-    if (fx) fx->eq_low = clampf(gain, 0.0f, 1.0f);
+    if (fx) store_param(&fx->eq_low, clampf(gain, 0.0f, 1.0f));
 }
 void regroove_effects_set_eq_mid(RegrooveEffects* fx, float gain) {
-    if (fx) fx->eq_mid = clampf(gain, 0.0f, 1.0f);
+    if (fx) store_param(&fx->eq_mid, clampf(gain, 0.0f, 1.0f));
 }
 void regroove_effects_set_eq_high(RegrooveEffects* fx, float gain) {
-    if (fx) fx->eq_high = clampf(gain, 0.0f, 1.0f);
+    if (fx) store_param(&fx->eq_high, clampf(gain, 0.0f, 1.0f));
 }
 int regroove_effects_get_eq_enabled(RegrooveEffects* fx) {
     return fx ? fx->eq_enabled : 0;
 }
 float regroove_effects_get_eq_low(RegrooveEffects* fx) {
-    return fx ? fx->eq_low : 0.5f;
+    return fx ? load_param(&fx->eq_low) : 0.5f;
 }
 float regroove_effects_get_eq_mid(RegrooveEffects* fx) {
-    return fx ? fx->eq_mid : 0.5f;
+    return fx ? load_param(&fx->eq_mid) : 0.5f;
 }
 float regroove_effects_get_eq_high(RegrooveEffects* fx) {
-    return fx ? fx->eq_high : 0.5f;
+    return fx ? load_param(&fx->eq_high) : 0.5f;
 }
 
 // Compressor setters/getters
@@ -471,37 +1135,37 @@ void regroove_effects_set_compressor_enabled(RegrooveEffects* fx, int enabled) {
     if (fx) fx->compressor_enabled = enabled;
 }
 void regroove_effects_set_compressor_threshold(RegrooveEffects* fx, float threshold) {
-    if (fx) fx->compressor_threshold = clampf(threshold, 0.0f, 1.0f);
+    if (fx) store_param(&fx->compressor_threshold, clampf(threshold, 0.0f, 1.0f));
 }
 void regroove_effects_set_compressor_ratio(RegrooveEffects* fx, float ratio) {
-    if (fx) fx->compressor_ratio = clampf(ratio, 0.0f, 1.0f);
+    if (fx) store_param(&fx->compressor_ratio, clampf(ratio, 0.0f, 1.0f));
 }
 void regroove_effects_set_compressor_attack(RegrooveEffects* fx, float attack) {
-    if (fx) fx->compressor_attack = clampf(attack, 0.0f, 1.0f);
+    if (fx) store_param(&fx->compressor_attack, clampf(attack, 0.0f, 1.0f));
 }
 void regroove_effects_set_compressor_release(RegrooveEffects* fx, float release) {
-    if (fx) fx->compressor_release = clampf(release, 0.0f, 1.0f);
+    if (fx) store_param(&fx->compressor_release, clampf(release, 0.0f, 1.0f));
 }
 void regroove_effects_set_compressor_makeup(RegrooveEffects* fx, float makeup) {
-    if (fx) fx->compressor_makeup = clampf(makeup, 0.0f, 1.0f);
+    if (fx) store_param(&fx->compressor_makeup, clampf(makeup, 0.0f, 1.0f));
 }
 int regroove_effects_get_compressor_enabled(RegrooveEffects* fx) {
     return fx ? fx->compressor_enabled : 0;
 }
 float regroove_effects_get_compressor_threshold(RegrooveEffects* fx) {
-    return fx ? fx->compressor_threshold : 0.7f;
+    return fx ? load_param(&fx->compressor_threshold) : 0.7f;
 }
 float regroove_effects_get_compressor_ratio(RegrooveEffects* fx) {
-    return fx ? fx->compressor_ratio : 0.5f;
+    return fx ? load_param(&fx->compressor_ratio) : 0.5f;
 }
 float regroove_effects_get_compressor_attack(RegrooveEffects* fx) {
-    return fx ? fx->compressor_attack : 0.1f;
+    return fx ? load_param(&fx->compressor_attack) : 0.1f;
 }
 float regroove_effects_get_compressor_release(RegrooveEffects* fx) {
-    return fx ? fx->compressor_release : 0.3f;
+    return fx ? load_param(&fx->compressor_release) : 0.3f;
 }
 float regroove_effects_get_compressor_makeup(RegrooveEffects* fx) {
-    return fx ? fx->compressor_makeup : 0.5f;
+    return fx ? load_param(&fx->compressor_makeup) : 0.5f;
 }
 
 // Phaser setters/getters
@@ -509,75 +1173,81 @@ void regroove_effects_set_phaser_enabled(RegrooveEffects* fx, int enabled) {
     if (fx) fx->phaser_enabled = enabled;
 }
 void regroove_effects_set_phaser_rate(RegrooveEffects* fx, float rate) {
-    if (fx) fx->phaser_rate = clampf(rate, 0.0f, 1.0f);
+    if (fx) store_param(&fx->phaser_rate, clampf(rate, 0.0f, 1.0f));
 }
 void regroove_effects_set_phaser_depth(RegrooveEffects* fx, float depth) {
-    if (fx) fx->phaser_depth = clampf(depth, 0.0f, 1.0f);
+    if (fx) store_param(&fx->phaser_depth, clampf(depth, 0.0f, 1.0f));
 }
 void regroove_effects_set_phaser_feedback(RegrooveEffects* fx, float feedback) {
-    if (fx) fx->phaser_feedback = clampf(feedback, 0.0f, 1.0f);
+    if (fx) store_param(&fx->phaser_feedback, clampf(feedback, 0.0f, 1.0f));
 }
 int regroove_effects_get_phaser_enabled(RegrooveEffects* fx) {
     return fx ? fx->phaser_enabled : 0;
 }
 float regroove_effects_get_phaser_rate(RegrooveEffects* fx) {
-    return fx ? fx->phaser_rate : 0.3f;
+    return fx ? load_param(&fx->phaser_rate) : 0.3f;
 }
 float regroove_effects_get_phaser_depth(RegrooveEffects* fx) {
-    return fx ? fx->phaser_depth : 0.5f;
+    return fx ? load_param(&fx->phaser_depth) : 0.5f;
 }
 float regroove_effects_get_phaser_feedback(RegrooveEffects* fx) {
-    return fx ? fx->phaser_feedback : 0.3f;
+    return fx ? load_param(&fx->phaser_feedback) : 0.3f;
 }
 
 // Reverb setters/getters
 void regroove_effects_set_reverb_enabled(RegrooveEffects* fx, int enabled) {
-    if (fx) fx->reverb_enabled = enabled;
+    if (!fx) return;
+    // Lines are allocated on first enable (never from the audio thread)
+    if (enabled && !regroove_effects_alloc_reverb(fx)) return;
+    fx->reverb_enabled = enabled;
 }
 void regroove_effects_set_reverb_room_size(RegrooveEffects* fx, float size) {
-    if (fx) fx->reverb_room_size = clampf(size, 0.0f, 1.0f);
+    if (fx) store_param(&fx->reverb_room_size, clampf(size, 0.0f, 1.0f));
 }
 void regroove_effects_set_reverb_damping(RegrooveEffects* fx, float damping) {
-    if (fx) fx->reverb_damping = clampf(damping, 0.0f, 1.0f);
+    if (fx) store_param(&fx->reverb_damping, clampf(damping, 0.0f, 1.0f));
 }
 void regroove_effects_set_reverb_mix(RegrooveEffects* fx, float mix) {
-    if (fx) fx->reverb_mix = clampf(mix, 0.0f, 1.0f);
+    if (fx) store_param(&fx->reverb_mix, clampf(mix, 0.0f, 1.0f));
 }
 int regroove_effects_get_reverb_enabled(RegrooveEffects* fx) {
     return fx ? fx->reverb_enabled : 0;
 }
 float regroove_effects_get_reverb_room_size(RegrooveEffects* fx) {
-    return fx ? fx->reverb_room_size : 0.5f;
+    return fx ? load_param(&fx->reverb_room_size) : 0.5f;
 }
 float regroove_effects_get_reverb_damping(RegrooveEffects* fx) {
-    return fx ? fx->reverb_damping : 0.5f;
+    return fx ? load_param(&fx->reverb_damping) : 0.5f;
 }
 float regroove_effects_get_reverb_mix(RegrooveEffects* fx) {
-    return fx ? fx->reverb_mix : 0.3f;
+    return fx ? load_param(&fx->reverb_mix) : 0.3f;
 }
 
 // Delay setters/getters
 void regroove_effects_set_delay_enabled(RegrooveEffects* fx, int enabled) {
-    if (fx) fx->delay_enabled = enabled;
+    if (!fx) return;
+    // Delay lines are allocated on first enable (never from the audio thread)
+    if (enabled && !regroove_effects_alloc_delay(fx)) return;
+    fx->delay_enabled = enabled;
 }
 void regroove_effects_set_delay_time(RegrooveEffects* fx, float time) {
-    if (fx) fx->delay_time = clampf(time, 0.0f, 1.0f);
+    if (fx) store_param(&fx->delay_time, clampf(time, 0.0f, 1.0f));
 }
 void regroove_effects_set_delay_feedback(RegrooveEffects* fx, float feedback) {
-    if (fx) fx->delay_feedback = clampf(feedback, 0.0f, 1.0f);
+    if (fx) store_param(&fx->delay_feedback, clampf(feedback, 0.0f, 1.0f));
 }
 void regroove_effects_set_delay_mix(RegrooveEffects* fx, float mix) {
-    if (fx) fx->delay_mix = clampf(mix, 0.0f, 1.0f);
+    if (fx) store_param(&fx->delay_mix, clampf(mix, 0.0f, 1.0f));
 }
 int regroove_effects_get_delay_enabled(RegrooveEffects* fx) {
     return fx ? fx->delay_enabled : 0;
 }
 float regroove_effects_get_delay_time(RegrooveEffects* fx) {
-    return fx ? fx->delay_time : 0.375f;
+    return fx ? load_param(&fx->delay_time) : 0.375f;
 }
 float regroove_effects_get_delay_feedback(RegrooveEffects* fx) {
-    return fx ? fx->delay_feedback : 0.4f;
+    return fx ? load_param(&fx->delay_feedback) : 0.4f;
 }
 float regroove_effects_get_delay_mix(RegrooveEffects* fx) {
-    return fx ? fx->delay_mix : 0.3f;
+    return fx ? load_param(&fx->delay_mix) : 0.3f;
 }
@@ -10,7 +10,38 @@ extern "C" {
 // Delay line size (1 second at 48kHz)
 #define MAX_DELAY_SAMPLES 48000
 
+// Reverb feedback delay network: number of delay lines
+#define REVERB_FDN_LINES 8
+
+// Audio-thread copies of the continuous parameters, ramped toward the
+// published targets once per block (see RegrooveEffects)
+typedef struct {
+    float distortion_drive;
+    float distortion_mix;
+    float filter_cutoff;
+    float filter_resonance;
+    float eq_low;
+    float eq_mid;
+    float eq_high;
+    float compressor_threshold;
+    float compressor_ratio;
+    float compressor_attack;
+    float compressor_release;
+    float compressor_makeup;
+    float phaser_rate;
+    float phaser_depth;
+    float phaser_feedback;
+    float reverb_room_size;
+    float reverb_damping;
+    float reverb_mix;
+    float delay_time;
+    float delay_feedback;
+    float delay_mix;
+} RegrooveEffectsParams;
+
 // Effects chain structure
+// The float parameters below are targets: setters publish them atomically
+// from any thread, and the audio thread only reads them once per block.
 typedef struct {
     // Distortion parameters
     int distortion_enabled;
@@ -71,14 +102,55 @@ typedef struct {
     float compressor_envelope[2]; // Compressor envelope followers
     float compressor_rms[2];      // RMS state for smoother detection
 
-    float phaser_lfo_phase;    // Phaser LFO phase
+    float phaser_lfo_phase;    // Phaser LFO phase (0.0 - 1.0 cycles)
     float phaser_ap[4][2];     // Phaser all-pass filter states (4 stages, stereo)
+    float phaser_fb[2];        // Phaser feedback state (L, R)
 
-    float reverb_comb[8][2];   // Reverb comb filter states (8 combs, stereo)
-    int reverb_comb_pos[8];    // Comb filter read positions
+    float *reverb_buffer;                    // FDN delay lines (one allocation, made on first enable)
+    int reverb_offset[REVERB_FDN_LINES];     // Start of each line in reverb_buffer
+    int reverb_length[REVERB_FDN_LINES];     // Active length of each line (sample rate dependent)
+    int reverb_pos[REVERB_FDN_LINES];        // Read/write position in each line
+    float reverb_damp[REVERB_FDN_LINES];     // Damping lowpass state per line
 
-    float *delay_buffer[2];    // Delay buffers (L, R)
+    float *delay_buffer[2];    // Delay buffers (L, R; one allocation, made on first enable)
     int delay_write_pos;       // Delay write position
+
+    // Smoothed parameters (audio thread only)
+    RegrooveEffectsParams smoothed;
+
+    // Derived coefficients (recomputed at most once per block, from smoothed)
+    int coeffs_dirty;          // Force a recompute on the next block
+    int coeffs_sample_rate;    // Sample rate the coefficients were derived for
+
+    float coef_distortion_hp_alpha;  // 80Hz pre-emphasis highpass
+    float coef_distortion_bp_f;      // 120Hz punch bump SVF frequency
+    float coef_distortion_lp_alpha;  // 8kHz post-filter
+    float coef_distortion_drive;     // Base drive gain (1x - 8x)
+
+    float coef_filter_f;       // Chamberlin SVF frequency coefficient
+    float coef_filter_q;       // Chamberlin SVF damping
+
+    float coef_eq_low_alpha;   // 250Hz split
+    float coef_eq_mid_alpha;   // 6kHz split
+    float coef_eq_low_mult;    // Linear band gains
+    float coef_eq_mid_mult;
+    float coef_eq_high_mult;
+
+    float coef_comp_attack;    // Envelope attack coefficient
+    float coef_comp_release;   // Envelope release coefficient
+    float coef_comp_threshold; // Linear threshold
+    float coef_comp_ratio;     // Ratio (1:1 - 20:1)
+    float coef_comp_makeup;    // Linear makeup gain
+
+    float coef_phaser_lfo_inc;   // LFO phase increment per sample (cycles)
+    float coef_phaser_min_freq;  // Lowest all-pass break frequency (Hz)
+    float coef_phaser_sweep;     // Sweep range as a frequency multiplier
+    float coef_phaser_feedback;  // Feedback gain
+
+    float coef_reverb_gain[REVERB_FDN_LINES];  // Per-line decay gain (from room size)
+    float coef_reverb_damp;                    // Damping lowpass coefficient
+
+    int coef_delay_samples;    // Delay time in samples
 } RegrooveEffects;
 
 // Initialize effects with default parameters
@@ -96,7 +168,19 @@ void regroove_effects_reset(RegrooveEffects* fx);
 // sample_rate: sample rate in Hz
 void regroove_effects_process(RegrooveEffects* fx, int16_t* buffer, int frames, int sample_rate);
 
+// Process planar float buffers through effects chain (in place, no clipping)
+// left, right: separate channel buffers, nominal range -1.0 to 1.0
+// frames: number of frames in each buffer
+// sample_rate: sample rate in Hz
+void regroove_effects_process_f32(RegrooveEffects* fx, float* left, float* right, int frames, int sample_rate);
+
+// Name of the stereo kernel set this build uses ("sse2", "neon" or "scalar")
+// Set REGROOVE_FX_SCALAR=1 in the environment to force the scalar reference path
+const char* regroove_effects_get_simd_name(void);
+
 // Parameter setters (normalized 0.0 - 1.0 for MIDI mapping)
+// Enabling delay or reverb allocates its buffer on first use, so call those
+// enable setters from a control thread, not from the audio callback.
 void regroove_effects_set_distortion_enabled(RegrooveEffects* fx, int enabled);
 void regroove_effects_set_distortion_drive(RegrooveEffects* fx, float drive);   // 0.0 - 1.0
 void regroove_effects_set_distortion_mix(RegrooveEffects* fx, float mix);       // 0.0 - 1.0
@@ -276,8 +276,14 @@ void samplecrate_mixer_init(SamplecrateMixer* mixer) {
         mixer->program_pans[i] = 0.5f;     // Center
         mixer->program_mutes[i] = 0;
         mixer->program_fx_enable[i] = 0;   // FX disabled by default
+        mixer->program_delay_sends[i] = 0.0f;   // No send by default
+        mixer->program_reverb_sends[i] = 0.0f;
     }
 
+    // Aux returns at unity so raising a send is audible right away
+    mixer->delay_return = 1.0f;
+    mixer->reverb_return = 1.0f;
+
     mixer->master_fx_enable = 1;  // Master FX enabled by default
 }
 
@@ -291,6 +297,7 @@ void samplecrate_config_init(SamplecrateConfig* config) {
     config->midi_output_device = -1;  // Not configured
     config->midi_input_channel = 0;  // Omni (all channels) by default
     config->audio_device = -1;   // Use default
+    config->render_threads = 1;  // Render on the audio thread only
     config->expanded_pads = 0;   // Normal 16 pads by default
     config->lock_ui_program_selection = 0;  // Allow UI control by default
     config->midi_program_change_enabled[0] = 1;  // Device 0: Accept MIDI program changes by default
@@ -300,6 +307,7 @@ void samplecrate_config_init(SamplecrateConfig* config) {
     // MIDI sync defaults
     config->midi_clock_tempo_sync = 1;  // Enabled by default (adjust tempo to MIDI clock)
     config->midi_spp_receive = 1;       // Enabled by default (sync to SPP)
+    config->midi_clock_send = 0;        // Disabled by default (follow, don't lead)
 
     // SysEx defaults
     config->sysex_device_id = 0;        // Device ID 0 by default
@@ -395,6 +403,7 @@ int samplecrate_config_load(SamplecrateConfig* config, const char* filepath) {
             else if (strcmp(key, "midi_output_device") == 0) config->midi_output_device = atoi(value);
             else if (strcmp(key, "midi_input_channel") == 0) config->midi_input_channel = atoi(value);
             else if (strcmp(key, "audio_device") == 0) config->audio_device = atoi(value);
+            else if (strcmp(key, "render_threads") == 0) config->render_threads = atoi(value);
             else if (strcmp(key, "expanded_pads") == 0) config->expanded_pads = atoi(value);
             else if (strcmp(key, "lock_ui_program_selection") == 0) config->lock_ui_program_selection = atoi(value);
             else if (strcmp(key, "midi_program_change_enabled_device_0") == 0) config->midi_program_change_enabled[0] = atoi(value);
@@ -402,6 +411,7 @@ int samplecrate_config_load(SamplecrateConfig* config, const char* filepath) {
             else if (strcmp(key, "midi_program_change_enabled_device_2") == 0) config->midi_program_change_enabled[2] = atoi(value);
             else if (strcmp(key, "midi_clock_tempo_sync") == 0) config->midi_clock_tempo_sync = atoi(value);
             else if (strcmp(key, "midi_spp_receive") == 0) config->midi_spp_receive = atoi(value);
+            else if (strcmp(key, "midi_clock_send") == 0) config->midi_clock_send = atoi(value);
             else if (strcmp(key, "sysex_device_id") == 0) config->sysex_device_id = atoi(value);
             // Legacy support for old config files
             else if (strcmp(key, "midi_program_change_enabled") == 0) {
@@ -461,12 +471,14 @@ int samplecrate_config_save(const SamplecrateConfig* config, const char* filepat
     fprintf(f, "midi_output_device=%d\n", config->midi_output_device);
     fprintf(f, "midi_input_channel=%d  ; 0 = Omni (all channels), 1-16 = specific channel\n", config->midi_input_channel);
     fprintf(f, "audio_device=%d\n", config->audio_device);
+    fprintf(f, "render_threads=%d  ; 1 = audio thread only, N = audio thread + N-1 workers\n", config->render_threads);
     fprintf(f, "expanded_pads=%d\n", config->expanded_pads);
     fprintf(f, "midi_program_change_enabled_device_0=%d\n", config->midi_program_change_enabled[0]);
     fprintf(f, "midi_program_change_enabled_device_1=%d\n", config->midi_program_change_enabled[1]);
     fprintf(f, "midi_program_change_enabled_device_2=%d\n", config->midi_program_change_enabled[2]);
     fprintf(f, "midi_clock_tempo_sync=%d  ; 0 = visual only, 1 = adjust playback tempo\n", config->midi_clock_tempo_sync);
     fprintf(f, "midi_spp_receive=%d  ; 0 = ignore SPP, 1 = sync to SPP\n", config->midi_spp_receive);
+    fprintf(f, "midi_clock_send=%d  ; 0 = off, 1 = send MIDI clock/SPP (master)\n", config->midi_clock_send);
     fprintf(f, "sysex_device_id=%d  ; SysEx device ID (0-127) for remote control\n", config->sysex_device_id);
     fprintf(f, "\n");
 
@@ -59,6 +59,14 @@ typedef struct {
     int program_mutes[RSX_MAX_PROGRAMS];      // Mute for each program
     int program_fx_enable[RSX_MAX_PROGRAMS];  // FX enable per program (0=disabled, 1=enabled)
 
+    // Per-program aux sends (post-fader) into the shared delay/reverb buses
+    float program_delay_sends[RSX_MAX_PROGRAMS];   // 0.0 - 1.0
+    float program_reverb_sends[RSX_MAX_PROGRAMS];  // 0.0 - 1.0
+
+    // Aux bus return levels (mixed into the playback channel)
+    float delay_return;        // 0.0 - 1.0
+    float reverb_return;       // 0.0 - 1.0
+
     // FX enable toggles (independent)
     int master_fx_enable;      // 0 = disabled, 1 = enabled
 } SamplecrateMixer;
@@ -72,6 +80,7 @@ typedef struct {
     int midi_output_device; // MIDI output device port (-1 = not configured)
     int midi_input_channel; // Global MIDI input channel filter (0 = Omni/all channels, 1-16 = specific channel)
     int audio_device;    // Audio output device (-1 = default)
+    int render_threads;  // Threads rendering programs (1 = audio thread only)
     int expanded_pads;   // 0 = 16 pads, 1 = 32 pads
     int lock_ui_program_selection;  // 0 = allow UI control, 1 = lock to MIDI only
     int midi_program_change_enabled[3];  // Per-device: 0 = ignore (UI selection leads), 1 = receive but don't change UI
@@ -79,6 +88,7 @@ typedef struct {
     // MIDI sync settings
     int midi_clock_tempo_sync;  // 0 = disabled (visual only), 1 = enabled (adjust playback tempo)
     int midi_spp_receive;       // 0 = disabled (ignore SPP), 1 = enabled (sync to SPP)
+    int midi_clock_send;        // 0 = disabled, 1 = send MIDI clock/SPP on the MIDI output (master)
 
     // SysEx settings
     int sysex_device_id;        // SysEx device ID (0-127) for remote control
@@ -2,17 +2,170 @@
 #include "sfz_builder.h"
 #include "medness_sequencer.h"
 #include "medness_performance.h"
+#include "samplecrate_worker_pool.h"
 #include <iostream>
 #include <cstring>
 #include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <thread>
+#include <deque>
+#include <atomic>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cassert>
+#include <cstdint>
+#include <cmath>
+#include <new>
+#include <cerrno>
 #include <libgen.h>
 
 extern "C" {
 #include "samplecrate_rsx.h"
 }
 
-// Mutex for thread-safe synth access
-static std::mutex synth_mutex;
+// =============================================================================
+// Background program loader
+// =============================================================================
+// Programs load on a loader thread into a fresh synth. The finished synth is
+// published in pending[] and the audio thread swaps it in at the start of a
+// block (samplecrate_engine_drain_events), so rendering never waits on disk
+// I/O. Synths the audio thread swaps out go through the retire ring back to
+// the loader thread, which frees them.
+
+// Retire ring capacity (power of two)
+#define ENGINE_RETIRE_SLOTS 128
+
+// Published in pending[] when a reload leaves the program empty
+static int engine_synth_removed_marker;
+#define ENGINE_SYNTH_REMOVED ((sfizz_synth_t*)&engine_synth_removed_marker)
+
+// Everything needed to build one program, copied from the RSX on the calling
+// thread so the UI can keep editing while the loader works
+struct ProgramLoadJob {
+    int program_idx;
+    uint32_t generation;
+    int mode;
+    bool empty;
+    int block_frames;                           // sfizz samples per block
+    std::string sfz_path;                       // PROGRAM_MODE_SFZ_FILE
+    std::string rsx_file;                       // For log messages
+    std::string base_path;                      // PROGRAM_MODE_SAMPLES: RSX directory
+    std::vector<RSXSampleMapping> samples;      // PROGRAM_MODE_SAMPLES: enabled samples
+    int sample_count;                           // As listed in the RSX (for log messages)
+};
+
+// A whole RSX loading in the background (samplecrate_engine_load_rsx_async)
+struct EngineKitLoad {
+    std::thread thread;
+    std::string path;
+    SamplecrateRSX* rsx;                        // The new file, parsed off the UI thread
+    sfizz_synth_t* synths[RSX_MAX_PROGRAMS];    // Its programs
+    int result;                                 // 0 = loaded, -1 = RSX could not be read
+    int failed_program;                         // Last program that failed to load, -1 = none
+    int built;                                  // Set (release) when the thread is done
+    int installed;                              // Set (release) once the synths are swapped in
+    bool published;
+};
+
+struct EngineLoader {
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;               // Jobs queued or quit
+    std::condition_variable idle;               // Queue drained and nothing building
+    std::deque<ProgramLoadJob> jobs;
+    uint32_t generation[RSX_MAX_PROGRAMS];      // Latest request per program (older jobs are dropped)
+    bool busy;
+    bool quit;
+
+    // Loader -> audio thread (swapped with __atomic_exchange_n)
+    sfizz_synth_t* pending[RSX_MAX_PROGRAMS];
+    EngineKitLoad* pending_kit;                 // A finished kit load (all programs at once)
+
+    // Audio thread -> loader thread (single producer, single consumer)
+    sfizz_synth_t* retired[ENGINE_RETIRE_SLOTS];
+    uint32_t retire_head;                       // Written by the audio thread
+    uint32_t retire_tail;                       // Written by the loader thread
+};
+
+static void engine_loader_main(SamplecrateEngine* engine);
+static void engine_loader_reclaim(EngineLoader* loader);
+static void engine_free_kit(EngineKitLoad* kit);
+
+// =============================================================================
+// Real-time allocation guard (debug builds)
+// =============================================================================
+#ifdef SAMPLECRATE_RT_ALLOC_GUARD
+static thread_local int rt_guard_depth = 0;
+
+static void rt_guard_trip(const char* what, std::size_t size) {
+    // Drop the guard first so reporting cannot recurse
+    rt_guard_depth = 0;
+    fprintf(stderr, "[RT GUARD] %s(%zu) on the audio thread\n", what, size);
+    assert(!"heap allocation inside the audio render path");
+}
+
+static void* rt_guard_alloc(std::size_t size) {
+    if (rt_guard_depth > 0) rt_guard_trip("operator new", size);
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(std::size_t size) { return rt_guard_alloc(size); }
+void* operator new[](std::size_t size) { return rt_guard_alloc(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+
+#if defined(__GLIBC__)
+// C allocations (effects code, sfizz, libc) are caught by interposing the
+// allocator entry points and forwarding to glibc's own implementation. This
+// covers shared libraries too, unlike --wrap. Elsewhere only operator new is
+// checked.
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+
+void* malloc(size_t size) noexcept {
+    if (rt_guard_depth > 0) rt_guard_trip("malloc", size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+    if (rt_guard_depth > 0) rt_guard_trip("calloc", count * size);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+    if (rt_guard_depth > 0) rt_guard_trip("realloc", size);
+    return __libc_realloc(ptr, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept {
+    if (rt_guard_depth > 0) rt_guard_trip("aligned_alloc", size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) noexcept {
+    if (rt_guard_depth > 0) rt_guard_trip("posix_memalign", size);
+    if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0) return EINVAL;
+    void* p = __libc_memalign(alignment, size);
+    if (!p) return ENOMEM;
+    *out = p;
+    return 0;
+}
+}
+#endif
+
+void samplecrate_rt_guard_begin(void) { rt_guard_depth++; }
+void samplecrate_rt_guard_end(void) { if (rt_guard_depth > 0) rt_guard_depth--; }
+#else
+void samplecrate_rt_guard_begin(void) {}
+void samplecrate_rt_guard_end(void) {}
+#endif
 
 // Cross-platform realpath wrapper
 static char* cross_platform_realpath(const char* path, char* resolved_path) {
@@ -31,12 +184,37 @@ SamplecrateEngine* samplecrate_engine_create(MednessSequencer* sequencer) {
     engine->rsx = nullptr;
     engine->synth = nullptr;
     engine->performance = nullptr;
+    engine->sequencer = sequencer;
     engine->effects_master = nullptr;
+    engine->effects_send_delay = nullptr;
+    engine->effects_send_reverb = nullptr;
+    engine->effects_program_init = nullptr;
+    engine->scratch_block = nullptr;
+    engine->scratch_frames = 0;
+    engine->synth_block_frames = ENGINE_SYNTH_BLOCK_FRAMES;
+    engine->render_pool = nullptr;
+    engine->render_slice_frames = 0;
+    engine->loader = nullptr;
+    engine->kit_load = nullptr;
+    engine->load_progress_callback = nullptr;
+    engine->load_progress_userdata = nullptr;
+    engine->audio_running = 0;
+    engine->render_programs = 0;
+    engine->delay_bus_tail = 0;
+    engine->reverb_bus_tail = 0;
+    for (int i = 0; i < ENGINE_SCRATCH_COUNT; i++) {
+        engine->scratch[i] = nullptr;
+    }
     engine->current_program = 0;
+    engine->pending_program = -1;
+    engine->failed_program = -1;
 
     for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
         engine->program_synths[i] = nullptr;
         engine->effects_program[i] = nullptr;
+        engine->program_rendered[i] = false;
+        engine->program_events_pending[i] = false;
+        engine->program_quiet_frames[i] = 0;
     }
 
     for (int i = 0; i < RSX_MAX_NOTE_PADS; i++) {
@@ -50,13 +228,32 @@ SamplecrateEngine* samplecrate_engine_create(MednessSequencer* sequencer) {
         }
     }
 
+    // Initialize note queues
+    for (int i = 0; i < RSX_MAX_PROGRAMS + 1; i++) {
+        samplecrate_event_queue_init(&engine->note_queues[i]);
+    }
+    engine->live_latency_frames = 0;
+
     // Initialize mixer
     samplecrate_mixer_init(&engine->mixer);
 
     // Create main synth
     engine->synth = sfizz_create_synth();
     sfizz_set_sample_rate(engine->synth, 44100);
-    sfizz_set_samples_per_block(engine->synth, 512);
+    sfizz_set_samples_per_block(engine->synth, engine->synth_block_frames);
+
+    // Start the background program loader
+    engine->loader = new EngineLoader();
+    for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
+        engine->loader->generation[i] = 0;
+        engine->loader->pending[i] = nullptr;
+    }
+    engine->loader->pending_kit = nullptr;
+    engine->loader->retire_head = 0;
+    engine->loader->retire_tail = 0;
+    engine->loader->busy = false;
+    engine->loader->quit = false;
+    engine->loader->thread = std::thread(engine_loader_main, engine);
 
     // Create performance manager (handles both pads and sequences)
     engine->performance = medness_performance_create();
@@ -67,10 +264,20 @@ SamplecrateEngine* samplecrate_engine_create(MednessSequencer* sequencer) {
         medness_performance_set_start_mode(engine->performance, SEQUENCE_START_IMMEDIATE);
     }
 
-    // Create effects
+    // Create effects (per-program chains are created when a program is loaded)
     engine->effects_master = regroove_effects_create();
-    for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
-        engine->effects_program[i] = regroove_effects_create();
+
+    // Shared aux buses: one delay and one reverb instance serve every program,
+    // each running fully wet so the return fader sets the effect level
+    engine->effects_send_delay = regroove_effects_create();
+    if (engine->effects_send_delay) {
+        regroove_effects_set_delay_enabled(engine->effects_send_delay, 1);
+        regroove_effects_set_delay_mix(engine->effects_send_delay, 1.0f);
+    }
+    engine->effects_send_reverb = regroove_effects_create();
+    if (engine->effects_send_reverb) {
+        regroove_effects_set_reverb_enabled(engine->effects_send_reverb, 1);
+        regroove_effects_set_reverb_mix(engine->effects_send_reverb, 1.0f);
     }
 
     return engine;
@@ -79,20 +286,49 @@ SamplecrateEngine* samplecrate_engine_create(MednessSequencer* sequencer) {
 void samplecrate_engine_destroy(SamplecrateEngine* engine) {
     if (!engine) return;
 
+    // Stop render workers before anything they touch goes away
+    samplecrate_worker_pool_destroy(engine->render_pool);
+
+    // Finish a kit load in progress and drop it
+    if (engine->kit_load) {
+        if (engine->loader) engine->loader->pending_kit = nullptr;
+        engine_free_kit(engine->kit_load);
+        engine->kit_load = nullptr;
+    }
+
+    // Stop the loader and free synths it left behind
+    if (engine->loader) {
+        {
+            std::lock_guard<std::mutex> lock(engine->loader->mutex);
+            engine->loader->quit = true;
+            engine->loader->jobs.clear();
+        }
+        engine->loader->wake.notify_all();
+        engine->loader->thread.join();
+        engine_loader_reclaim(engine->loader);
+        for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
+            sfizz_synth_t* unclaimed = engine->loader->pending[i];
+            if (unclaimed && unclaimed != ENGINE_SYNTH_REMOVED) sfizz_free(unclaimed);
+        }
+        delete engine->loader;
+    }
+
     // Free RSX
     if (engine->rsx) {
         samplecrate_rsx_destroy(engine->rsx);
     }
 
-    // Free synths
-    if (engine->synth) {
-        sfizz_free(engine->synth);
-    }
+    // Free synths (engine->synth may also be one of the program synths)
+    bool synth_is_program = false;
     for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
         if (engine->program_synths[i]) {
+            if (engine->program_synths[i] == engine->synth) synth_is_program = true;
             sfizz_free(engine->program_synths[i]);
         }
     }
+    if (engine->synth && !synth_is_program) {
+        sfizz_free(engine->synth);
+    }
 
     // Free performance manager
     if (engine->performance) {
@@ -108,6 +344,15 @@ void samplecrate_engine_destroy(SamplecrateEngine* engine) {
             regroove_effects_destroy(engine->effects_program[i]);
         }
     }
+    if (engine->effects_send_delay) {
+        regroove_effects_destroy(engine->effects_send_delay);
+    }
+    if (engine->effects_send_reverb) {
+        regroove_effects_destroy(engine->effects_send_reverb);
+    }
+
+    // Free audio scratch arena
+    free(engine->scratch_block);
 
     delete engine;
 }
@@ -147,82 +392,96 @@ void samplecrate_engine_save_note_suppression(SamplecrateEngine* engine) {
     samplecrate_rsx_save(engine->rsx, engine->rsx_file_path.c_str());
 }
 
-int samplecrate_engine_reload_program(SamplecrateEngine* engine, int program_idx) {
-    if (!engine || !engine->rsx || program_idx < 0 || program_idx >= RSX_MAX_PROGRAMS) return -1;
+// Snapshot a program's load description from an RSX
+static void engine_make_load_job(const SamplecrateRSX* r, const std::string& rsx_file_path, int program_idx,
+                                 ProgramLoadJob* job) {
+    job->program_idx = program_idx;
+    job->generation = 0;
+    job->mode = r->program_modes[program_idx];
+    job->empty = (job->mode == PROGRAM_MODE_SFZ_FILE && r->program_files[program_idx][0] == '\0') ||
+                 (job->mode == PROGRAM_MODE_SAMPLES && r->program_sample_counts[program_idx] == 0);
+    job->rsx_file = r->program_files[program_idx];
+    job->sample_count = r->program_sample_counts[program_idx];
+    job->sfz_path.clear();
+    job->base_path.clear();
+    job->samples.clear();
+    if (job->empty) return;
+
+    if (job->mode == PROGRAM_MODE_SFZ_FILE) {
+        char sfz_path[512];
+        samplecrate_rsx_get_sfz_path(rsx_file_path.c_str(), r->program_files[program_idx], sfz_path, sizeof(sfz_path));
+        job->sfz_path = sfz_path;
+    } else if (job->mode == PROGRAM_MODE_SAMPLES) {
+        for (int s = 0; s < r->program_sample_counts[program_idx]; s++) {
+            const RSXSampleMapping* sample = &r->program_samples[program_idx][s];
+            if (sample->enabled && sample->sample_path[0] != '\0') {
+                job->samples.push_back(*sample);
+            }
+        }
 
-    std::lock_guard<std::mutex> lock(synth_mutex);
+        // Get RSX directory to write temp file
+        char rsx_dir[512];
+        strncpy(rsx_dir, rsx_file_path.c_str(), sizeof(rsx_dir) - 1);
+        rsx_dir[sizeof(rsx_dir) - 1] = '\0';
 
-    // Free existing synth if it exists
-    if (engine->program_synths[program_idx]) {
-        sfizz_free(engine->program_synths[program_idx]);
-        engine->program_synths[program_idx] = nullptr;
+        char* dir = dirname(rsx_dir);
+        char absolute_dir[1024];
+        char* resolved = cross_platform_realpath(dir, absolute_dir);
+        job->base_path = resolved ? absolute_dir : dir;
     }
+}
 
-    // Skip if no content to load
-    if (engine->rsx->program_modes[program_idx] == PROGRAM_MODE_SFZ_FILE && engine->rsx->program_files[program_idx][0] == '\0') return 0;
-    if (engine->rsx->program_modes[program_idx] == PROGRAM_MODE_SAMPLES && engine->rsx->program_sample_counts[program_idx] == 0) return 0;
+// Build a program's synth from a job (any thread, touches no engine state).
+// Returns 0 with *out_synth set (NULL for an empty program), or -1 on failure.
+static int engine_build_program_synth(const ProgramLoadJob* job, sfizz_synth_t** out_synth) {
+    *out_synth = nullptr;
+    if (job->empty) return 0;
 
     // Create new synth instance
-    engine->program_synths[program_idx] = sfizz_create_synth();
-    sfizz_set_sample_rate(engine->program_synths[program_idx], 44100);
-    sfizz_set_samples_per_block(engine->program_synths[program_idx], 512);
+    sfizz_synth_t* new_synth = sfizz_create_synth();
+    sfizz_set_sample_rate(new_synth, 44100);
+    sfizz_set_samples_per_block(new_synth, job->block_frames);
 
     bool load_success = false;
+    int program_number = job->program_idx + 1;
 
-    if (engine->rsx->program_modes[program_idx] == PROGRAM_MODE_SFZ_FILE) {
+    if (job->mode == PROGRAM_MODE_SFZ_FILE) {
         // Load from SFZ file
-        char sfz_path[512];
-        samplecrate_rsx_get_sfz_path(engine->rsx_file_path.c_str(), engine->rsx->program_files[program_idx], sfz_path, sizeof(sfz_path));
-
-        std::cout << "Reloading Program " << (program_idx + 1) << " (SFZ File: " << engine->rsx->program_files[program_idx] << ")" << std::endl;
-        if (sfizz_load_file(engine->program_synths[program_idx], sfz_path)) {
+        std::cout << "Reloading Program " << program_number << " (SFZ File: " << job->rsx_file << ")" << std::endl;
+        if (sfizz_load_file(new_synth, job->sfz_path.c_str())) {
             load_success = true;
-            int num_regions = sfizz_get_num_regions(engine->program_synths[program_idx]);
+            int num_regions = sfizz_get_num_regions(new_synth);
             std::cout << "  SUCCESS: Loaded " << num_regions << " regions" << std::endl;
         } else {
-            std::cerr << "ERROR: Failed to load program " << (program_idx + 1) << ": " << sfz_path << std::endl;
+            std::cerr << "ERROR: Failed to load program " << program_number << ": " << job->sfz_path << std::endl;
         }
     }
-    else if (engine->rsx->program_modes[program_idx] == PROGRAM_MODE_SAMPLES) {
+    else if (job->mode == PROGRAM_MODE_SAMPLES) {
         // Build from samples
-        std::cout << "Reloading Program " << (program_idx + 1) << " (Samples: " << engine->rsx->program_sample_counts[program_idx] << ")" << std::endl;
+        std::cout << "Reloading Program " << program_number << " (Samples: " << job->sample_count << ")" << std::endl;
 
         SFZBuilder* builder = sfz_builder_create(44100);
         if (builder) {
-            for (int s = 0; s < engine->rsx->program_sample_counts[program_idx]; s++) {
-                RSXSampleMapping* sample = &engine->rsx->program_samples[program_idx][s];
-
-                if (sample->enabled && sample->sample_path[0] != '\0') {
-                    std::cout << "  Sample " << (s + 1) << ": " << sample->sample_path << std::endl;
-
-                    sfz_builder_add_region(builder,
-                                          sample->sample_path,
-                                          sample->key_low,
-                                          sample->key_high,
-                                          sample->root_key,
-                                          sample->vel_low,
-                                          sample->vel_high,
-                                          sample->amplitude,
-                                          sample->pan);
-                }
+            for (const RSXSampleMapping& sample : job->samples) {
+                std::cout << "  Sample: " << sample.sample_path << std::endl;
+
+                sfz_builder_add_region(builder,
+                                      sample.sample_path,
+                                      sample.key_low,
+                                      sample.key_high,
+                                      sample.root_key,
+                                      sample.vel_low,
+                                      sample.vel_high,
+                                      sample.amplitude,
+                                      sample.pan);
             }
 
-            // Get RSX directory to write temp file
-            char rsx_dir[512];
-            strncpy(rsx_dir, engine->rsx_file_path.c_str(), sizeof(rsx_dir) - 1);
-            rsx_dir[sizeof(rsx_dir) - 1] = '\0';
-
-            char* dir = dirname(rsx_dir);
-            char absolute_dir[1024];
-            char* resolved = cross_platform_realpath(dir, absolute_dir);
-            const char* base_path = resolved ? absolute_dir : dir;
-
-            if (sfz_builder_load(builder, engine->program_synths[program_idx], base_path) == 0) {
+            if (sfz_builder_load(builder, new_synth, job->base_path.c_str()) == 0) {
                 load_success = true;
-                int num_regions = sfizz_get_num_regions(engine->program_synths[program_idx]);
+                int num_regions = sfizz_get_num_regions(new_synth);
                 std::cout << "  SUCCESS: Built " << num_regions << " regions" << std::endl;
             } else {
-                std::cerr << "ERROR: Failed to build program " << (program_idx + 1) << " from samples" << std::endl;
+                std::cerr << "ERROR: Failed to build program " << program_number << " from samples" << std::endl;
             }
 
             sfz_builder_destroy(builder);
@@ -230,75 +489,435 @@ int samplecrate_engine_reload_program(SamplecrateEngine* engine, int program_idx
     }
 
     if (!load_success) {
-        engine->error_message = "Failed to load\nProgram " + std::to_string(program_idx + 1);
-        sfizz_free(engine->program_synths[program_idx]);
-        engine->program_synths[program_idx] = nullptr;
+        sfizz_free(new_synth);
         return -1;
-    } else {
-        engine->error_message = "";  // Clear error on success
+    }
+    *out_synth = new_synth;
+    return 0;
+}
+
+// Free synths the audio thread has swapped out (loader thread)
+static void engine_loader_reclaim(EngineLoader* loader) {
+    uint32_t head = __atomic_load_n(&loader->retire_head, __ATOMIC_ACQUIRE);
+    uint32_t tail = loader->retire_tail;
+    while (tail != head) {
+        sfizz_free(loader->retired[tail & (ENGINE_RETIRE_SLOTS - 1)]);
+        tail++;
+    }
+    __atomic_store_n(&loader->retire_tail, tail, __ATOMIC_RELEASE);
+}
+
+static void engine_loader_main(SamplecrateEngine* engine) {
+    EngineLoader* loader = engine->loader;
+    std::unique_lock<std::mutex> lock(loader->mutex);
+
+    while (!loader->quit) {
+        if (loader->jobs.empty()) {
+            loader->idle.notify_all();
+            // Wake periodically to free retired synths
+            loader->wake.wait_for(lock, std::chrono::milliseconds(50));
+            lock.unlock();
+            engine_loader_reclaim(loader);
+            lock.lock();
+            continue;
+        }
+
+        ProgramLoadJob job = std::move(loader->jobs.front());
+        loader->jobs.pop_front();
+        int idx = job.program_idx;
+        if (job.generation != loader->generation[idx]) continue;  // Superseded by a newer request
+
+        loader->busy = true;
+        lock.unlock();
+        sfizz_synth_t* new_synth = nullptr;
+        int result = engine_build_program_synth(&job, &new_synth);
+        lock.lock();
+        loader->busy = false;
+
+        // Drop results that were superseded while building
+        if (job.generation != loader->generation[idx]) {
+            if (new_synth) sfizz_free(new_synth);
+            continue;
+        }
 
-        // Update main synth pointer if this is the current program
-        if (engine->current_program == program_idx) {
-            engine->synth = engine->program_synths[program_idx];
+        if (result != 0) {
+            // Keep the old synth playing
+            __atomic_store_n(&engine->failed_program, idx, __ATOMIC_RELEASE);
+            continue;
         }
-        return 0;
+        __atomic_store_n(&engine->failed_program, -1, __ATOMIC_RELEASE);  // Clear error on success
+
+        // Publish; a result the audio thread never picked up is freed here
+        sfizz_synth_t* published = new_synth ? new_synth : ENGINE_SYNTH_REMOVED;
+        sfizz_synth_t* unclaimed = __atomic_exchange_n(&loader->pending[idx], published, __ATOMIC_ACQ_REL);
+        if (unclaimed && unclaimed != ENGINE_SYNTH_REMOVED) sfizz_free(unclaimed);
     }
+    loader->idle.notify_all();
 }
 
-int samplecrate_engine_load_rsx(SamplecrateEngine* engine, const char* rsx_path) {
-    if (!engine || !rsx_path) return -1;
+// Drop queued and in-flight loads without waiting for them. A build still
+// running is discarded by the loader when it finishes (its generation is
+// stale, and the loader checks that under the mutex before publishing).
+// Published synths the audio thread hasn't swapped in yet are freed (the
+// exchange decides who owns them, so this is safe while audio runs).
+static void engine_loader_cancel(SamplecrateEngine* engine) {
+    EngineLoader* loader = engine->loader;
+    if (!loader) return;
+
+    std::lock_guard<std::mutex> lock(loader->mutex);
+    loader->jobs.clear();
+    for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
+        loader->generation[i]++;
+    }
 
-    // Create RSX structure if not exists
-    if (!engine->rsx) {
-        engine->rsx = samplecrate_rsx_create();
+    for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
+        sfizz_synth_t* unclaimed = __atomic_exchange_n(&loader->pending[i], (sfizz_synth_t*)nullptr, __ATOMIC_ACQ_REL);
+        if (unclaimed && unclaimed != ENGINE_SYNTH_REMOVED) sfizz_free(unclaimed);
     }
+}
 
-    // Clean up ALL existing program synths before loading new file
-    // (in case the new file has fewer programs than the old one)
-    std::cout << "Cleaning up existing programs..." << std::endl;
+// Programs the audio thread renders: up to the last one with a synth. Kept
+// with the synths it counts, so rendering never reads the RSX the UI edits.
+static void engine_update_render_programs(SamplecrateEngine* engine) {
+    int count = 0;
     for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
-        if (engine->program_synths[i]) {
-            sfizz_free(engine->program_synths[i]);
-            engine->program_synths[i] = nullptr;
+        if (engine->program_synths[i]) count = i + 1;
+    }
+    __atomic_store_n(&engine->render_programs, count, __ATOMIC_RELEASE);
+}
+
+// Swap a finished kit's synths in for all programs at once. The old synths
+// are retired to the loader (retire = true, audio thread) or freed here
+// (audio stopped).
+static void engine_install_kit(SamplecrateEngine* engine, EngineKitLoad* kit, bool retire) {
+    EngineLoader* loader = engine->loader;
+    uint32_t head = loader->retire_head;
+    bool synth_replaced = false;
+
+    for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
+        sfizz_synth_t* old = engine->program_synths[i];
+        __atomic_store_n(&engine->program_synths[i], kit->synths[i], __ATOMIC_RELEASE);
+        kit->synths[i] = nullptr;
+        engine->program_events_pending[i] = false;
+        engine->program_quiet_frames[i] = 0;
+        if (!old) continue;
+
+        if (old == engine->synth) synth_replaced = true;
+        if (retire) {
+            loader->retired[head & (ENGINE_RETIRE_SLOTS - 1)] = old;
+            head++;
+        } else {
+            sfizz_free(old);
+        }
+    }
+    if (retire) __atomic_store_n(&loader->retire_head, head, __ATOMIC_RELEASE);
+
+    // The kit starts on program 1
+    if (engine->program_synths[0] || synth_replaced) engine->synth = engine->program_synths[0];
+    __atomic_store_n(&engine->pending_program, -1, __ATOMIC_RELEASE);  // Meant for the old kit
+    engine_update_render_programs(engine);
+    __atomic_store_n(&kit->installed, 1, __ATOMIC_RELEASE);
+}
+
+// Swap in programs the loader has finished (audio thread, start of block)
+static void engine_install_loaded_programs(SamplecrateEngine* engine) {
+    EngineLoader* loader = engine->loader;
+    if (!loader) return;
+
+    // A new kit replaces every program in the same block
+    if (__atomic_load_n(&loader->pending_kit, __ATOMIC_ACQUIRE)) {
+        int in_use = 0;
+        for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
+            if (engine->program_synths[i]) in_use++;
+        }
+        uint32_t tail = __atomic_load_n(&loader->retire_tail, __ATOMIC_ACQUIRE);
+        if (loader->retire_head - tail + in_use > ENGINE_RETIRE_SLOTS) return;  // Loader is behind: next block
+
+        EngineKitLoad* kit = __atomic_exchange_n(&loader->pending_kit, (EngineKitLoad*)nullptr, __ATOMIC_ACQ_REL);
+        if (kit) engine_install_kit(engine, kit, true);
+    }
+
+    for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
+        if (!__atomic_load_n(&loader->pending[i], __ATOMIC_RELAXED)) continue;
+
+        // The old synth needs a retire slot; if the loader is behind, try next block
+        uint32_t head = loader->retire_head;
+        uint32_t tail = __atomic_load_n(&loader->retire_tail, __ATOMIC_ACQUIRE);
+        if (head - tail >= ENGINE_RETIRE_SLOTS) return;
+
+        sfizz_synth_t* loaded = __atomic_exchange_n(&loader->pending[i], (sfizz_synth_t*)nullptr, __ATOMIC_ACQ_REL);
+        if (loaded == ENGINE_SYNTH_REMOVED) loaded = nullptr;
+
+        sfizz_synth_t* old = engine->program_synths[i];
+        __atomic_store_n(&engine->program_synths[i], loaded, __ATOMIC_RELEASE);
+        if (engine->current_program == i || (old && engine->synth == old)) engine->synth = loaded;
+        engine->program_events_pending[i] = false;
+        engine->program_quiet_frames[i] = 0;
+
+        if (old) {
+            loader->retired[head & (ENGINE_RETIRE_SLOTS - 1)] = old;
+            __atomic_store_n(&loader->retire_head, head + 1, __ATOMIC_RELEASE);
         }
+        engine_update_render_programs(engine);
     }
+}
+
+int samplecrate_engine_reload_program(SamplecrateEngine* engine, int program_idx) {
+    if (!engine || !engine->rsx || !engine->loader || program_idx < 0 || program_idx >= RSX_MAX_PROGRAMS) return -1;
+
+    ProgramLoadJob job;
+    engine_make_load_job(engine->rsx, engine->rsx_file_path, program_idx, &job);
+    job.block_frames = __atomic_load_n(&engine->synth_block_frames, __ATOMIC_ACQUIRE);
+
+    // Program exists: make sure it has an FX chain (cheap, delay/reverb lines stay lazy)
+    if (!job.empty) samplecrate_engine_ensure_program_effects(engine, program_idx);
+
+    EngineLoader* loader = engine->loader;
+    std::lock_guard<std::mutex> lock(loader->mutex);
+    job.generation = ++loader->generation[program_idx];
+    loader->jobs.push_back(std::move(job));
+    loader->wake.notify_one();
+    return 0;
+}
+
+void samplecrate_engine_wait_for_loads(SamplecrateEngine* engine) {
+    if (!engine || !engine->loader) return;
+
+    EngineLoader* loader = engine->loader;
+    std::unique_lock<std::mutex> lock(loader->mutex);
+    loader->idle.wait(lock, [loader] { return (loader->jobs.empty() && !loader->busy) || loader->quit; });
+}
+
+int samplecrate_engine_get_failed_program(SamplecrateEngine* engine) {
+    if (!engine) return -1;
+    return __atomic_load_n(&engine->failed_program, __ATOMIC_ACQUIRE);
+}
+
+// Build every program of a kit, spread over up to this many threads
+#define ENGINE_MAX_LOAD_THREADS 8
+
+// Parse the kit's RSX and build all its programs in parallel (kit thread, or
+// the caller of samplecrate_engine_load_rsx). Touches no live engine state
+// except the FX chains (created on demand, lock-free).
+static void engine_build_kit(SamplecrateEngine* engine, EngineKitLoad* kit) {
+    for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
+        kit->synths[i] = nullptr;
+    }
+    kit->result = -1;
 
     // Load the RSX file
-    if (samplecrate_rsx_load(engine->rsx, rsx_path) != 0) {
-        std::cerr << "Failed to load RSX file: " << rsx_path << std::endl;
-        return -1;
+    kit->rsx = samplecrate_rsx_create();
+    if (!kit->rsx || samplecrate_rsx_load(kit->rsx, kit->path.c_str()) != 0) {
+        std::cerr << "Failed to load RSX file: " << kit->path << std::endl;
+        __atomic_store_n(&kit->built, 1, __ATOMIC_RELEASE);
+        return;
+    }
+    std::cout << "Loaded RSX file: " << kit->path << std::endl;
+
+    std::vector<ProgramLoadJob> jobs;
+    for (int i = 0; i < kit->rsx->num_programs && i < RSX_MAX_PROGRAMS; i++) {
+        ProgramLoadJob job;
+        engine_make_load_job(kit->rsx, kit->path, i, &job);
+        job.block_frames = __atomic_load_n(&engine->synth_block_frames, __ATOMIC_ACQUIRE);
+        if (job.empty) continue;
+        samplecrate_engine_ensure_program_effects(engine, i);
+        jobs.push_back(std::move(job));
+    }
+
+    // Fan the programs out: each thread takes the next unbuilt one
+    int total = (int)jobs.size();
+    std::atomic<int> next(0);
+    std::atomic<int> done(0);
+    std::mutex report_mutex;
+    auto report = [engine, total](int loaded) {
+        if (engine->load_progress_callback) {
+            engine->load_progress_callback(loaded, total, engine->load_progress_userdata);
+        }
+    };
+    auto worker = [&]() {
+        int k;
+        while ((k = next++) < total) {
+            const ProgramLoadJob* job = &jobs[k];
+            sfizz_synth_t* built = nullptr;
+            int result = engine_build_program_synth(job, &built);
+            kit->synths[job->program_idx] = built;
+
+            std::lock_guard<std::mutex> lock(report_mutex);
+            if (result != 0) kit->failed_program = job->program_idx;
+            report(++done);
+        }
+    };
+
+    report(0);
+    int num_threads = (int)std::thread::hardware_concurrency();
+    if (num_threads < 1) num_threads = 1;
+    if (num_threads > ENGINE_MAX_LOAD_THREADS) num_threads = ENGINE_MAX_LOAD_THREADS;
+    if (num_threads > total) num_threads = total;
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < num_threads; t++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
     }
 
-    std::cout << "Loaded RSX file: " << rsx_path << std::endl;
-    engine->rsx_file_path = rsx_path;
+    std::cout << "Loaded " << total << " program(s) on " << (num_threads > 0 ? num_threads : 1) << " thread(s)" << std::endl;
+    kit->result = 0;
+    __atomic_store_n(&kit->built, 1, __ATOMIC_RELEASE);
+}
 
-    // Reload all programs from the new file
-    for (int i = 0; i < engine->rsx->num_programs; i++) {
-        samplecrate_engine_reload_program(engine, i);
+// Adopt an installed kit's RSX and reset to its first program (UI thread)
+static void engine_finish_kit(SamplecrateEngine* engine, EngineKitLoad* kit) {
+    // Create RSX structure if not exists
+    if (!engine->rsx) {
+        engine->rsx = samplecrate_rsx_create();
     }
+    memcpy(engine->rsx, kit->rsx, sizeof(SamplecrateRSX));
+    engine->rsx_file_path = kit->path;
+    __atomic_store_n(&engine->failed_program, kit->failed_program, __ATOMIC_RELEASE);
 
     // Load note suppression settings
     samplecrate_engine_load_note_suppression(engine);
 
+    // Kit timing and feel (the sequencer takes them over at its next block)
+    if (engine->sequencer) {
+        medness_sequencer_set_time_signature(engine->sequencer, engine->rsx->beats_per_bar, engine->rsx->beat_unit);
+        medness_sequencer_set_pattern_bars(engine->sequencer, engine->rsx->pattern_bars);
+        medness_sequencer_set_swing(engine->sequencer, engine->rsx->swing);
+        MednessGroove groove;
+        medness_sequencer_set_groove(engine->sequencer, medness_performance_groove_from_rsx(&engine->rsx->groove, &groove));
+    }
+
     // Note: Pad MIDI files are loaded in main.cpp where per-pad callback contexts are available
 
     // Reset to program 0
     engine->current_program = 0;
-    if (engine->program_synths[0]) {
-        engine->synth = engine->program_synths[0];
+}
+
+// Free a kit load and anything it still owns
+static void engine_free_kit(EngineKitLoad* kit) {
+    if (kit->thread.joinable()) kit->thread.join();
+    for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
+        if (kit->synths[i]) sfizz_free(kit->synths[i]);
+    }
+    samplecrate_rsx_destroy(kit->rsx);
+    delete kit;
+}
+
+static EngineKitLoad* engine_new_kit(const char* rsx_path) {
+    EngineKitLoad* kit = new EngineKitLoad();
+    kit->path = rsx_path;
+    kit->rsx = nullptr;
+    kit->result = -1;
+    kit->failed_program = -1;
+    kit->built = 0;
+    kit->installed = 0;
+    kit->published = false;
+    for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
+        kit->synths[i] = nullptr;
+    }
+    return kit;
+}
+
+int samplecrate_engine_load_rsx(SamplecrateEngine* engine, const char* rsx_path) {
+    if (!engine || !rsx_path) return -1;
+    if (engine->kit_load) {
+        std::cerr << "[ENGINE] A kit is already loading" << std::endl;
+        return -1;
+    }
+
+    // Build first: if the file can't be read the current kit stays
+    EngineKitLoad* kit = engine_new_kit(rsx_path);
+    engine_build_kit(engine, kit);
+    if (kit->result != 0) {
+        engine_free_kit(kit);
+        return -1;
+    }
+
+    // Pending background reloads belong to the old file
+    engine_loader_cancel(engine);
+
+    // The audio thread is stopped, so the old synths are freed right here
+    std::cout << "Cleaning up existing programs..." << std::endl;
+    engine_install_kit(engine, kit, false);
+    engine_finish_kit(engine, kit);
+    engine_free_kit(kit);
+    return 0;
+}
+
+int samplecrate_engine_load_rsx_async(SamplecrateEngine* engine, const char* rsx_path) {
+    if (!engine || !rsx_path || !engine->loader) return -1;
+    if (engine->kit_load) {
+        std::cerr << "[ENGINE] A kit is already loading" << std::endl;
+        return -1;
     }
-    // Note: if program_synths[0] is NULL, engine->synth retains the default synth created during engine init
 
+    EngineKitLoad* kit = engine_new_kit(rsx_path);
+    engine->kit_load = kit;
+    kit->thread = std::thread(engine_build_kit, engine, kit);
     return 0;
 }
 
+SamplecrateKitLoadState samplecrate_engine_poll_rsx_load(SamplecrateEngine* engine) {
+    if (!engine || !engine->kit_load) return ENGINE_KIT_LOAD_IDLE;
+    EngineKitLoad* kit = engine->kit_load;
+    EngineLoader* loader = engine->loader;
+
+    if (!__atomic_load_n(&kit->built, __ATOMIC_ACQUIRE)) return ENGINE_KIT_LOAD_BUSY;
+
+    if (!kit->published) {
+        kit->thread.join();
+        if (kit->result != 0) {
+            engine->kit_load = nullptr;
+            engine_free_kit(kit);
+            return ENGINE_KIT_LOAD_FAILED;
+        }
+
+        // Pending background reloads belong to the old file
+        engine_loader_cancel(engine);
+
+        // Hand the kit to the audio thread
+        kit->published = true;
+        __atomic_store_n(&loader->pending_kit, kit, __ATOMIC_RELEASE);
+        return ENGINE_KIT_LOAD_BUSY;
+    }
+
+    if (!__atomic_load_n(&kit->installed, __ATOMIC_ACQUIRE)) {
+        // Only when no audio callback can run (see set_audio_running) is it safe
+        // to free the old synths here; otherwise the audio thread takes the kit
+        if (engine->audio_running) return ENGINE_KIT_LOAD_BUSY;
+        if (__atomic_exchange_n(&loader->pending_kit, (EngineKitLoad*)nullptr, __ATOMIC_ACQ_REL) != kit) {
+            return ENGINE_KIT_LOAD_BUSY;  // The audio thread took it after all
+        }
+        engine_install_kit(engine, kit, false);
+    }
+
+    engine_finish_kit(engine, kit);
+    engine->kit_load = nullptr;
+    engine_free_kit(kit);
+    return ENGINE_KIT_LOAD_DONE;
+}
+
+void samplecrate_engine_set_audio_running(SamplecrateEngine* engine, int running) {
+    if (!engine) return;
+    engine->audio_running = running ? 1 : 0;
+}
+
+void samplecrate_engine_set_load_progress_callback(SamplecrateEngine* engine,
+                                                   void (*callback)(int loaded, int total, void* userdata),
+                                                   void* userdata) {
+    if (!engine) return;
+    engine->load_progress_callback = callback;
+    engine->load_progress_userdata = userdata;
+}
+
 void samplecrate_engine_switch_program(SamplecrateEngine* engine, int program_idx) {
-    if (!engine || !engine->rsx || program_idx < 0 || program_idx >= engine->rsx->num_programs) return;
+    if (!engine || program_idx < 0 || program_idx >= RSX_MAX_PROGRAMS) return;
 
     engine->current_program = program_idx;
-    engine->synth = engine->program_synths[program_idx];
-
-    std::cout << "Switched to program " << (program_idx + 1) << std::endl;
+    __atomic_store_n(&engine->pending_program, program_idx, __ATOMIC_RELEASE);
 }
 
 void samplecrate_engine_autosave_effects(SamplecrateEngine* engine) {
@@ -309,9 +928,545 @@ void samplecrate_engine_autosave_effects(SamplecrateEngine* engine) {
     // For now, just placeholder
 }
 
+void samplecrate_engine_apply_send_settings(SamplecrateEngine* engine) {
+    if (!engine || !engine->rsx) return;
+
+    SamplecrateRSX* rsx = engine->rsx;
+
+    // Send levels and returns go to the mixer
+    for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
+        engine->mixer.program_delay_sends[i] = rsx->program_delay_sends[i];
+        engine->mixer.program_reverb_sends[i] = rsx->program_reverb_sends[i];
+    }
+    engine->mixer.delay_return = rsx->delay_return;
+    engine->mixer.reverb_return = rsx->reverb_return;
+
+    // Bus parameters (enable/mix stay fixed: buses are always fully wet)
+    if (engine->effects_send_delay) {
+        regroove_effects_set_delay_time(engine->effects_send_delay, rsx->send_effects.delay_time);
+        regroove_effects_set_delay_feedback(engine->effects_send_delay, rsx->send_effects.delay_feedback);
+    }
+    if (engine->effects_send_reverb) {
+        regroove_effects_set_reverb_room_size(engine->effects_send_reverb, rsx->send_effects.reverb_room_size);
+        regroove_effects_set_reverb_damping(engine->effects_send_reverb, rsx->send_effects.reverb_damping);
+    }
+}
+
+void samplecrate_engine_apply_rsx_mix(SamplecrateEngine* engine) {
+    if (!engine || !engine->rsx || engine->rsx->num_programs <= 0) return;
+
+    SamplecrateRSX* rsx = engine->rsx;
+
+    // Program volume and pan
+    for (int i = 0; i < rsx->num_programs; i++) {
+        engine->mixer.program_volumes[i] = rsx->program_volumes[i];
+        engine->mixer.program_pans[i] = rsx->program_pans[i];
+        std::cout << "Applied program " << (i + 1) << " settings: volume=" << engine->mixer.program_volumes[i]
+                  << " pan=" << engine->mixer.program_pans[i] << std::endl;
+    }
+
+    // FX chain enable states
+    engine->mixer.master_fx_enable = rsx->master_fx_enable;
+    for (int i = 0; i < rsx->num_programs; i++) {
+        engine->mixer.program_fx_enable[i] = rsx->program_fx_enable[i];
+    }
+
+    // Aux send levels and shared bus settings
+    samplecrate_engine_apply_send_settings(engine);
+
+    // Effects settings
+    std::cout << "Loading effects settings from RSX..." << std::endl;
+    if (engine->effects_master) {
+        samplecrate_engine_apply_rsx_effects(engine->effects_master, &rsx->master_effects);
+        std::cout << "  Master effects loaded from RSX (enabled=" << engine->mixer.master_fx_enable << ")" << std::endl;
+    }
+    for (int i = 0; i < rsx->num_programs; i++) {
+        if (engine->effects_program[i]) {
+            samplecrate_engine_apply_rsx_effects(engine->effects_program[i], &rsx->program_effects[i]);
+            std::cout << "  Program " << (i + 1) << " effects loaded from RSX (enabled="
+                      << engine->mixer.program_fx_enable[i] << ")" << std::endl;
+        }
+    }
+}
+
+void samplecrate_engine_apply_rsx_effects(RegrooveEffects* fx, const RSXEffectsSettings* rsx_fx) {
+    if (!fx || !rsx_fx) return;
+
+    // Distortion
+    regroove_effects_set_distortion_enabled(fx, rsx_fx->distortion_enabled);
+    regroove_effects_set_distortion_drive(fx, rsx_fx->distortion_drive);
+    regroove_effects_set_distortion_mix(fx, rsx_fx->distortion_mix);
+
+    // Filter
+    regroove_effects_set_filter_enabled(fx, rsx_fx->filter_enabled);
+    regroove_effects_set_filter_cutoff(fx, rsx_fx->filter_cutoff);
+    regroove_effects_set_filter_resonance(fx, rsx_fx->filter_resonance);
+
+    // EQ
+    regroove_effects_set_eq_enabled(fx, rsx_fx->eq_enabled);
+    regroove_effects_set_eq_low(fx, rsx_fx->eq_low);
+    regroove_effects_set_eq_mid(fx, rsx_fx->eq_mid);
+    regroove_effects_set_eq_high(fx, rsx_fx->eq_high);
+
+    // Compressor
+    regroove_effects_set_compressor_enabled(fx, rsx_fx->compressor_enabled);
+    regroove_effects_set_compressor_threshold(fx, rsx_fx->compressor_threshold);
+    regroove_effects_set_compressor_ratio(fx, rsx_fx->compressor_ratio);
+    regroove_effects_set_compressor_attack(fx, rsx_fx->compressor_attack);
+    regroove_effects_set_compressor_release(fx, rsx_fx->compressor_release);
+    regroove_effects_set_compressor_makeup(fx, rsx_fx->compressor_makeup);
+
+    // Phaser
+    regroove_effects_set_phaser_enabled(fx, rsx_fx->phaser_enabled);
+    regroove_effects_set_phaser_rate(fx, rsx_fx->phaser_rate);
+    regroove_effects_set_phaser_depth(fx, rsx_fx->phaser_depth);
+    regroove_effects_set_phaser_feedback(fx, rsx_fx->phaser_feedback);
+
+    // Reverb
+    regroove_effects_set_reverb_enabled(fx, rsx_fx->reverb_enabled);
+    regroove_effects_set_reverb_room_size(fx, rsx_fx->reverb_room_size);
+    regroove_effects_set_reverb_damping(fx, rsx_fx->reverb_damping);
+    regroove_effects_set_reverb_mix(fx, rsx_fx->reverb_mix);
+
+    // Delay
+    regroove_effects_set_delay_enabled(fx, rsx_fx->delay_enabled);
+    regroove_effects_set_delay_time(fx, rsx_fx->delay_time);
+    regroove_effects_set_delay_feedback(fx, rsx_fx->delay_feedback);
+    regroove_effects_set_delay_mix(fx, rsx_fx->delay_mix);
+}
+
+RegrooveEffects* samplecrate_engine_ensure_program_effects(SamplecrateEngine* engine, int program_idx) {
+    if (!engine || program_idx < 0 || program_idx >= RSX_MAX_PROGRAMS) return nullptr;
+
+    RegrooveEffects* fx = __atomic_load_n(&engine->effects_program[program_idx], __ATOMIC_ACQUIRE);
+    if (fx) return fx;
+
+    fx = regroove_effects_create();
+    if (!fx) return nullptr;
+    if (engine->effects_program_init) {
+        engine->effects_program_init(fx);
+    }
+
+    // Publish fully initialized; lose the race gracefully if another thread won
+    RegrooveEffects* expected = nullptr;
+    if (!__atomic_compare_exchange_n(&engine->effects_program[program_idx], &expected, fx,
+                                     false, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE)) {
+        regroove_effects_destroy(fx);
+        return expected;
+    }
+    return fx;
+}
+
+// Let every synth render blocks of up to max_frames (audio stopped). sfizz
+// refuses blocks longer than it was set up for and outputs nothing.
+static void engine_set_synth_block_frames(SamplecrateEngine* engine, int max_frames) {
+    if (max_frames <= engine->synth_block_frames) return;
+
+    __atomic_store_n(&engine->synth_block_frames, max_frames, __ATOMIC_RELEASE);
+    if (engine->synth) sfizz_set_samples_per_block(engine->synth, max_frames);
+    for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
+        if (engine->program_synths[i] && engine->program_synths[i] != engine->synth) {
+            sfizz_set_samples_per_block(engine->program_synths[i], max_frames);
+        }
+    }
+}
+
+int samplecrate_engine_prepare_audio(SamplecrateEngine* engine, int max_frames) {
+    if (!engine || max_frames <= 0) return -1;
+    engine_set_synth_block_frames(engine, max_frames);
+    if (engine->scratch_block && engine->scratch_frames >= max_frames) return 0;
+
+    // Round each buffer up to a whole number of cache lines so every buffer
+    // in the arena starts aligned
+    const int floats_per_line = ENGINE_SCRATCH_ALIGN / (int)sizeof(float);
+    int stride = (max_frames + floats_per_line - 1) / floats_per_line * floats_per_line;
+    size_t bytes = (size_t)stride * ENGINE_SCRATCH_COUNT * sizeof(float) + ENGINE_SCRATCH_ALIGN;
+
+    void* block = calloc(1, bytes);
+    if (!block) {
+        std::cerr << "[ENGINE] Failed to allocate audio scratch arena (" << bytes << " bytes)" << std::endl;
+        return -1;
+    }
+
+    uintptr_t aligned = ((uintptr_t)block + ENGINE_SCRATCH_ALIGN - 1) & ~(uintptr_t)(ENGINE_SCRATCH_ALIGN - 1);
+    free(engine->scratch_block);
+    engine->scratch_block = block;
+    for (int i = 0; i < ENGINE_SCRATCH_COUNT; i++) {
+        engine->scratch[i] = (float*)aligned + (size_t)i * stride;
+    }
+    engine->scratch_frames = max_frames;
+
+    std::cout << "[ENGINE] Audio scratch arena: " << ENGINE_SCRATCH_COUNT << " x " << max_frames
+              << " frames (" << bytes << " bytes)" << std::endl;
+    return 0;
+}
+
+int samplecrate_engine_queue_note(SamplecrateEngine* engine, int program, int note, int velocity, int on) {
+    return samplecrate_engine_queue_note_at(engine, program, note, velocity, on, 0);
+}
+
+int samplecrate_engine_queue_note_at(SamplecrateEngine* engine, int program, int note, int velocity, int on,
+                                     int frame_offset) {
+    if (!engine || note < 0 || note > 127 || program >= RSX_MAX_PROGRAMS) return -1;
+
+    SamplecrateEvent event;
+    event.type = on ? SAMPLECRATE_EVENT_NOTE_ON : SAMPLECRATE_EVENT_NOTE_OFF;
+    event.note = (uint8_t)note;
+    event.velocity = (uint8_t)(velocity < 0 ? 0 : (velocity > 127 ? 127 : velocity));
+    event.reserved = 0;
+    event.delay = frame_offset > 0 ? frame_offset : 0;
+    event.timestamp_us = 0;
+
+    int queue_index = (program < 0) ? ENGINE_EVENT_QUEUE_MAIN : program;
+    return samplecrate_event_queue_push(&engine->note_queues[queue_index], &event);
+}
+
+int samplecrate_engine_queue_note_timed(SamplecrateEngine* engine, int program, int note, int velocity, int on,
+                                        uint64_t timestamp_us) {
+    if (!engine || note < 0 || note > 127 || program >= RSX_MAX_PROGRAMS) return -1;
+
+    SamplecrateEvent event;
+    event.type = on ? SAMPLECRATE_EVENT_NOTE_ON : SAMPLECRATE_EVENT_NOTE_OFF;
+    event.note = (uint8_t)note;
+    event.velocity = (uint8_t)(velocity < 0 ? 0 : (velocity > 127 ? 127 : velocity));
+    event.reserved = 0;
+    event.delay = 0;
+    event.timestamp_us = timestamp_us;
+
+    int queue_index = (program < 0) ? ENGINE_EVENT_QUEUE_MAIN : program;
+    return samplecrate_event_queue_push(&engine->note_queues[queue_index], &event);
+}
+
+void samplecrate_engine_set_live_latency(SamplecrateEngine* engine, int latency_frames) {
+    if (!engine) return;
+    engine->live_latency_frames = latency_frames > 0 ? latency_frames : 0;
+}
+
+// Apply one queued event to a synth (events for unloaded programs are dropped)
+static void apply_note_event(SamplecrateEngine* engine, sfizz_synth_t* target_synth, const SamplecrateEvent* event,
+                             int max_delay, uint64_t block_time_us) {
+    if (!target_synth) return;
+
+    // sfizz delay = frame offset into the next rendered block
+    int delay = event->delay;
+    if (event->timestamp_us != 0 && block_time_us != 0) {
+        // Timed note: it sounds live_latency_frames after it was played. Notes
+        // that missed that point (late callback) play at once.
+        double since_block = ((double)event->timestamp_us - (double)block_time_us) * 1e-6 * 44100.0;
+        delay = (int)(since_block + 0.5) + engine->live_latency_frames;
+        if (delay < 0) delay = 0;
+    }
+    if (delay > max_delay) delay = max_delay;
+    if (event->type == SAMPLECRATE_EVENT_NOTE_ON) {
+        sfizz_send_note_on(target_synth, delay, event->note, event->velocity);
+    } else {
+        sfizz_send_note_off(target_synth, delay, event->note, 0);
+    }
+}
+
+void samplecrate_engine_drain_events(SamplecrateEngine* engine, int block_frames, uint64_t block_time_us) {
+    if (!engine) return;
+
+    // Programs finished loading in the background take over from this block
+    engine_install_loaded_programs(engine);
+
+    // Program switch from another thread: the current synth is only changed here
+    int program = __atomic_exchange_n(&engine->pending_program, -1, __ATOMIC_ACQ_REL);
+    if (program >= 0) engine->synth = engine->program_synths[program];
+
+    int max_delay = block_frames > 0 ? block_frames - 1 : 0;
+    SamplecrateEvent event;
+    for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
+        while (samplecrate_event_queue_pop(&engine->note_queues[i], &event)) {
+            apply_note_event(engine, engine->program_synths[i], &event, max_delay, block_time_us);
+            // Wakes the program if it was idle (see engine_render_program_task)
+            engine->program_events_pending[i] = true;
+        }
+    }
+    while (samplecrate_event_queue_pop(&engine->note_queues[ENGINE_EVENT_QUEUE_MAIN], &event)) {
+        apply_note_event(engine, engine->synth, &event, max_delay, block_time_us);
+    }
+}
+
+// FX output below this peak counts as silence (about -100 dBFS)
+#define PROGRAM_TAIL_THRESHOLD 1.0e-5f
+// A chain must stay below the threshold this long before it stops: one full
+// delay line, so a quiet gap between echoes doesn't cut the tail
+#define PROGRAM_TAIL_HOLD_FRAMES MAX_DELAY_SAMPLES
+
+// Render one program (synth, pre-fader FX, volume/pan/mute) into its own
+// scratch buffers. Runs on the audio thread or a render worker; programs
+// share nothing here, so any number can run at once.
+// Idle programs are skipped: the synth only renders while it has voices or
+// new notes, and the FX chain only until its tail has decayed. Muted or
+// zero-volume programs keep their voices running but skip FX and the mix.
+static void engine_render_program_task(void* ctx, int program_idx) {
+    SamplecrateEngine* engine = (SamplecrateEngine*)ctx;
+    sfizz_synth_t* synth = engine->program_synths[program_idx];
+    engine->program_rendered[program_idx] = false;
+    if (!synth) return;
+
+    const int frames = engine->render_slice_frames;
+    SamplecrateMixer* mixer = &engine->mixer;
+    float* prog_left = engine->scratch[ENGINE_SCRATCH_PROGRAMS + 2 * program_idx];
+    float* prog_right = engine->scratch[ENGINE_SCRATCH_PROGRAMS + 2 * program_idx + 1];
+
+    bool synth_active = engine->program_events_pending[program_idx] || sfizz_get_num_active_voices(synth) > 0;
+    engine->program_events_pending[program_idx] = false;
+
+    RegrooveEffects* prog_fx = __atomic_load_n(&engine->effects_program[program_idx], __ATOMIC_ACQUIRE);
+    bool fx_enabled = prog_fx && mixer->program_fx_enable[program_idx];
+    if (synth_active) engine->program_quiet_frames[program_idx] = 0;
+    bool fx_tail = fx_enabled && engine->program_quiet_frames[program_idx] < PROGRAM_TAIL_HOLD_FRAMES;
+    if (!synth_active && !fx_tail) return;
+
+    samplecrate_rt_guard_begin();
+
+    // Clear program buffers
+    memset(prog_left, 0, (size_t)frames * sizeof(float));
+    memset(prog_right, 0, (size_t)frames * sizeof(float));
+
+    // Render this program's audio
+    if (synth_active) {
+        float* prog_channels[2] = { prog_left, prog_right };
+        sfizz_render_block(synth, prog_channels, 2, frames);
+    }
+
+    // Silent at the fader: the voices above still advance, nothing else is needed.
+    // Nothing of the FX tail is heard either, so once the synth is quiet the
+    // program goes idle instead of running the tail out
+    float prog_vol = mixer->program_mutes[program_idx] ? 0.0f : mixer->program_volumes[program_idx];
+    if (prog_vol <= 0.0f) {
+        if (!synth_active) engine->program_quiet_frames[program_idx] = PROGRAM_TAIL_HOLD_FRAMES;
+        samplecrate_rt_guard_end();
+        return;
+    }
+
+    // Apply per-program FX if enabled (pre-fader); chains are created off this thread
+    if (fx_enabled) {
+        regroove_effects_process_f32(prog_fx, prog_left, prog_right, frames, 44100);
+
+        // Track the tail once the synth has gone quiet
+        if (!synth_active) {
+            float peak = 0.0f;
+            for (int j = 0; j < frames; j++) {
+                float l = fabsf(prog_left[j]);
+                float r = fabsf(prog_right[j]);
+                if (l > peak) peak = l;
+                if (r > peak) peak = r;
+            }
+            if (peak < PROGRAM_TAIL_THRESHOLD) {
+                engine->program_quiet_frames[program_idx] += frames;
+            } else {
+                engine->program_quiet_frames[program_idx] = 0;
+            }
+        }
+    }
+
+    // Apply per-program pan
+    float prog_pan = mixer->program_pans[program_idx];
+    float prog_left_gain = 1.0f - prog_pan;
+    float prog_right_gain = prog_pan;
+
+    // Apply per-program volume
+    for (int j = 0; j < frames; j++) {
+        prog_left[j] *= prog_vol * prog_left_gain;
+        prog_right[j] *= prog_vol * prog_right_gain;
+    }
+    engine->program_rendered[program_idx] = true;
+    samplecrate_rt_guard_end();
+}
+
+// Render one slice (frames <= scratch_frames) into the scratch mix buffers
+static void engine_render_slice(SamplecrateEngine* engine, int frames) {
+    const size_t bytes = (size_t)frames * sizeof(float);
+    SamplecrateMixer* mixer = &engine->mixer;
+    int num_programs = __atomic_load_n(&engine->render_programs, __ATOMIC_ACQUIRE);
+
+    // Main mix buffers
+    float* left = engine->scratch[ENGINE_SCRATCH_MIX_LEFT];
+    float* right = engine->scratch[ENGINE_SCRATCH_MIX_RIGHT];
+    memset(left, 0, bytes);
+    memset(right, 0, bytes);
+
+    // Aux send bus inputs (shared delay/reverb)
+    float* delay_send_left = engine->scratch[ENGINE_SCRATCH_DELAY_SEND_LEFT];
+    float* delay_send_right = engine->scratch[ENGINE_SCRATCH_DELAY_SEND_RIGHT];
+    float* reverb_send_left = engine->scratch[ENGINE_SCRATCH_REVERB_SEND_LEFT];
+    float* reverb_send_right = engine->scratch[ENGINE_SCRATCH_REVERB_SEND_RIGHT];
+    memset(delay_send_left, 0, bytes);
+    memset(delay_send_right, 0, bytes);
+    memset(reverb_send_left, 0, bytes);
+    memset(reverb_send_right, 0, bytes);
+    bool delay_bus_fed = false;
+    bool reverb_bus_fed = false;
+
+    // If we have multiple program synths loaded, mix them all together
+    if (num_programs > 0) {
+        // Render every program into its own buffer (in parallel with a pool)
+        engine->render_slice_frames = frames;
+        samplecrate_worker_pool_run(engine->render_pool, engine_render_program_task, engine, num_programs);
+
+        // Sum in program order so the mix doesn't depend on thread timing
+        for (int i = 0; i < num_programs; i++) {
+            if (!engine->program_rendered[i]) continue;
+            const float* prog_left = engine->scratch[ENGINE_SCRATCH_PROGRAMS + 2 * i];
+            const float* prog_right = engine->scratch[ENGINE_SCRATCH_PROGRAMS + 2 * i + 1];
+
+            // Mix into main buffers
+            for (int j = 0; j < frames; j++) {
+                left[j] += prog_left[j];
+                right[j] += prog_right[j];
+            }
+
+            // Post-fader aux sends
+            float delay_send = mixer->program_delay_sends[i];
+            if (delay_send > 0.0f) {
+                for (int j = 0; j < frames; j++) {
+                    delay_send_left[j] += prog_left[j] * delay_send;
+                    delay_send_right[j] += prog_right[j] * delay_send;
+                }
+                delay_bus_fed = true;
+            }
+            float reverb_send = mixer->program_reverb_sends[i];
+            if (reverb_send > 0.0f) {
+                for (int j = 0; j < frames; j++) {
+                    reverb_send_left[j] += prog_left[j] * reverb_send;
+                    reverb_send_right[j] += prog_right[j] * reverb_send;
+                }
+                reverb_bus_fed = true;
+            }
+        }
+    } else if (engine->synth) {
+        // Single synth mode (no programs)
+        float* channels[2] = { left, right };
+        sfizz_render_block(engine->synth, channels, 2, frames);
+    }
+
+    // Shared aux buses: process once per block and mix the returns.
+    // Buses keep running for a while after their sends stop so tails ring out.
+    const int BUS_TAIL_FRAMES = 44100 * 6;  // Longest delay feedback / reverb decay
+    if (delay_bus_fed) engine->delay_bus_tail = BUS_TAIL_FRAMES;
+    if (reverb_bus_fed) engine->reverb_bus_tail = BUS_TAIL_FRAMES;
+
+    if (engine->effects_send_delay && engine->delay_bus_tail > 0) {
+        regroove_effects_process_f32(engine->effects_send_delay, delay_send_left, delay_send_right, frames, 44100);
+        float delay_return = mixer->delay_return;
+        for (int i = 0; i < frames; i++) {
+            left[i] += delay_send_left[i] * delay_return;
+            right[i] += delay_send_right[i] * delay_return;
+        }
+        engine->delay_bus_tail -= frames;
+    }
+    if (engine->effects_send_reverb && engine->reverb_bus_tail > 0) {
+        regroove_effects_process_f32(engine->effects_send_reverb, reverb_send_left, reverb_send_right, frames, 44100);
+        float reverb_return = mixer->reverb_return;
+        for (int i = 0; i < frames; i++) {
+            left[i] += reverb_send_left[i] * reverb_return;
+            right[i] += reverb_send_right[i] * reverb_return;
+        }
+        engine->reverb_bus_tail -= frames;
+    }
+
+    // Apply playback volume and pan
+    // Pan: 0.0 = left, 0.5 = center (both at 100%), 1.0 = right
+    float playback_vol = mixer->playback_mute ? 0.0f : mixer->playback_volume;
+    float playback_pan = mixer->playback_pan;
+
+    // Constant-power panning: center should be full volume on both channels
+    float playback_left_gain = playback_vol * (playback_pan <= 0.5f ? 1.0f : (1.0f - (playback_pan - 0.5f) * 2.0f));
+    float playback_right_gain = playback_vol * (playback_pan >= 0.5f ? 1.0f : (playback_pan * 2.0f));
+
+    for (int i = 0; i < frames; i++) {
+        left[i] *= playback_left_gain;
+        right[i] *= playback_right_gain;
+    }
+
+    // Apply master volume and pan
+    float master_vol = mixer->master_mute ? 0.0f : mixer->master_volume;
+    float master_pan = mixer->master_pan;
+
+    // Constant-power panning: center should be full volume on both channels
+    float master_left_gain = master_vol * (master_pan <= 0.5f ? 1.0f : (1.0f - (master_pan - 0.5f) * 2.0f));
+    float master_right_gain = master_vol * (master_pan >= 0.5f ? 1.0f : (master_pan * 2.0f));
+
+    for (int i = 0; i < frames; i++) {
+        left[i] *= master_left_gain;
+        right[i] *= master_right_gain;
+    }
+
+    // Apply master effects if enabled
+    if (engine->effects_master && mixer->master_fx_enable) {
+        regroove_effects_process_f32(engine->effects_master, left, right, frames, 44100);
+    }
+}
+
 void samplecrate_engine_render_audio(SamplecrateEngine* engine, float* left, float* right, int num_frames) {
-    // This would be implemented for headless rendering
-    // For now, just placeholder
+    if (!left || !right || num_frames <= 0) return;
+    if (!engine || engine->scratch_frames <= 0) {
+        memset(left, 0, (size_t)num_frames * sizeof(float));
+        memset(right, 0, (size_t)num_frames * sizeof(float));
+        return;
+    }
+
+    samplecrate_rt_guard_begin();
+    for (int offset = 0; offset < num_frames; offset += engine->scratch_frames) {
+        int slice = num_frames - offset;
+        if (slice > engine->scratch_frames) slice = engine->scratch_frames;
+        engine_render_slice(engine, slice);
+        memcpy(left + offset, engine->scratch[ENGINE_SCRATCH_MIX_LEFT], (size_t)slice * sizeof(float));
+        memcpy(right + offset, engine->scratch[ENGINE_SCRATCH_MIX_RIGHT], (size_t)slice * sizeof(float));
+    }
+    samplecrate_rt_guard_end();
+}
+
+void samplecrate_engine_render_audio_interleaved(SamplecrateEngine* engine, float* out, int num_frames) {
+    if (!out || num_frames <= 0) return;
+    if (!engine || engine->scratch_frames <= 0) {
+        memset(out, 0, (size_t)num_frames * 2 * sizeof(float));
+        return;
+    }
+
+    samplecrate_rt_guard_begin();
+    for (int offset = 0; offset < num_frames; offset += engine->scratch_frames) {
+        int slice = num_frames - offset;
+        if (slice > engine->scratch_frames) slice = engine->scratch_frames;
+        engine_render_slice(engine, slice);
+
+        // Interleave the channels into the output buffer
+        const float* left = engine->scratch[ENGINE_SCRATCH_MIX_LEFT];
+        const float* right = engine->scratch[ENGINE_SCRATCH_MIX_RIGHT];
+        float* dst = out + (size_t)offset * 2;
+        for (int i = 0; i < slice; i++) {
+            dst[i * 2] = left[i];
+            dst[i * 2 + 1] = right[i];
+        }
+    }
+    samplecrate_rt_guard_end();
+}
+
+int samplecrate_engine_set_render_threads(SamplecrateEngine* engine, int num_threads) {
+    if (!engine) return -1;
+
+    int workers = num_threads > 1 ? num_threads - 1 : 0;
+    if (workers == samplecrate_worker_pool_get_workers(engine->render_pool)) return 0;
+
+    samplecrate_worker_pool_destroy(engine->render_pool);
+    engine->render_pool = nullptr;
+    if (workers > 0) {
+        engine->render_pool = samplecrate_worker_pool_create(workers);
+        if (!engine->render_pool) {
+            std::cerr << "[ENGINE] Failed to start render workers, rendering on the audio thread" << std::endl;
+            return -1;
+        }
+    }
+    std::cout << "[ENGINE] Rendering programs on " << (workers + 1) << " thread(s)" << std::endl;
+    return 0;
+}
+
+int samplecrate_engine_get_render_threads(SamplecrateEngine* engine) {
+    if (!engine) return 1;
+    return samplecrate_worker_pool_get_workers(engine->render_pool) + 1;
 }
 
 // Internal structure for pad MIDI callback context
@@ -325,7 +1480,7 @@ struct PadMidiContext {
 static PadMidiContext pad_midi_contexts[RSX_MAX_NOTE_PADS];
 
 // Internal MIDI callback for pad playback - handles synth routing
-static void engine_pad_midi_callback(int note, int velocity, int on, void* userdata) {
+static void engine_pad_midi_callback(int note, int velocity, int on, int frame_offset, void* userdata) {
     PadMidiContext* ctx = (PadMidiContext*)userdata;
     if (!ctx || !ctx->engine) return;
 
@@ -333,15 +1488,8 @@ static void engine_pad_midi_callback(int note, int velocity, int on, void* userd
     int pad_index = ctx->pad_index;
     int target_program = engine->pad_program_numbers[pad_index];
 
-    // Send to target program synth (ENGINE RESPONSIBILITY)
-    sfizz_synth_t* target_synth = engine->program_synths[target_program];
-    if (target_synth) {
-        if (on) {
-            sfizz_send_note_on(target_synth, 0, note, velocity);
-        } else {
-            sfizz_send_note_off(target_synth, 0, note, 0);
-        }
-    }
+    // Queue for the target program synth (ENGINE RESPONSIBILITY)
+    samplecrate_engine_queue_note_at(engine, target_program, note, velocity, on, frame_offset);
 
     // Trigger visual feedback (UI RESPONSIBILITY - optional callback)
     if (ctx->visual_feedback_callback) {
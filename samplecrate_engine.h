@@ -5,11 +5,46 @@
 #include "samplecrate_rsx.h"
 #include "regroove_effects.h"
 #include "samplecrate_common.h"
+#include "samplecrate_event_queue.h"
 #include <string>
 
+// Audio scratch buffers (planar, one arena owned by the engine)
+enum {
+    ENGINE_SCRATCH_MIX_LEFT,
+    ENGINE_SCRATCH_MIX_RIGHT,
+    ENGINE_SCRATCH_DELAY_SEND_LEFT,
+    ENGINE_SCRATCH_DELAY_SEND_RIGHT,
+    ENGINE_SCRATCH_REVERB_SEND_LEFT,
+    ENGINE_SCRATCH_REVERB_SEND_RIGHT,
+    // Per-program output: program i uses PROGRAMS + 2*i (left) and + 2*i + 1 (right),
+    // so programs can render in parallel and be summed in order afterwards
+    ENGINE_SCRATCH_PROGRAMS,
+    ENGINE_SCRATCH_COUNT = ENGINE_SCRATCH_PROGRAMS + 2 * RSX_MAX_PROGRAMS
+};
+
+// Scratch buffer alignment in bytes (cache line)
+#define ENGINE_SCRATCH_ALIGN 64
+
+// sfizz block size of new synths until prepare_audio asks for larger blocks
+#define ENGINE_SYNTH_BLOCK_FRAMES 512
+
+// Note queue index for the current/legacy synth (engine->synth)
+#define ENGINE_EVENT_QUEUE_MAIN RSX_MAX_PROGRAMS
+
 // Forward declarations
 struct MednessSequencer;
 struct MednessPerformance;
+struct SamplecrateWorkerPool;
+struct EngineLoader;
+struct EngineKitLoad;
+
+// Background kit load state (samplecrate_engine_poll_rsx_load)
+typedef enum {
+    ENGINE_KIT_LOAD_IDLE = 0,    // Nothing loading
+    ENGINE_KIT_LOAD_BUSY = 1,    // Programs still building (the old kit keeps playing)
+    ENGINE_KIT_LOAD_DONE = 2,    // New kit swapped in (reported once)
+    ENGINE_KIT_LOAD_FAILED = 3   // RSX could not be read, old kit kept (reported once)
+} SamplecrateKitLoadState;
 
 // Engine state structure
 typedef struct {
@@ -23,21 +58,58 @@ typedef struct {
 
     // Sequence/performance manager (handles both pads and sequences)
     MednessPerformance* performance;
+    MednessSequencer* sequencer;                 // Shared sequencer (not owned)
     int pad_program_numbers[RSX_MAX_NOTE_PADS];  // Program number for each pad
 
     // Effects
     RegrooveEffects* effects_master;
-    RegrooveEffects* effects_program[RSX_MAX_PROGRAMS];  // Per-program FX chains
+    RegrooveEffects* effects_program[RSX_MAX_PROGRAMS];  // Per-program FX chains (created on demand)
+    void (*effects_program_init)(RegrooveEffects* fx);   // Optional: applies defaults to new chains
+    RegrooveEffects* effects_send_delay;   // Shared delay aux bus (100% wet)
+    RegrooveEffects* effects_send_reverb;  // Shared reverb aux bus (100% wet)
+
+    // Note events for the audio thread: one queue per program plus one for
+    // the current synth (ENGINE_EVENT_QUEUE_MAIN)
+    SamplecrateEventQueue note_queues[RSX_MAX_PROGRAMS + 1];
+    int live_latency_frames;    // Delay from a timed note's timestamp to its sound
 
     // Mixer
     SamplecrateMixer mixer;
 
+    // Audio scratch arena (allocated by samplecrate_engine_prepare_audio)
+    void* scratch_block;                         // Raw allocation (unaligned)
+    float* scratch[ENGINE_SCRATCH_COUNT];        // Aligned per-buffer pointers
+    int scratch_frames;                          // Frames per scratch buffer
+    int synth_block_frames;                      // sfizz samples per block of every synth (>= scratch_frames)
+
+    // Parallel program rendering (NULL = everything on the audio thread)
+    SamplecrateWorkerPool* render_pool;
+    int render_slice_frames;                     // Frames of the slice being rendered
+    bool program_rendered[RSX_MAX_PROGRAMS];     // Program produced output this slice
+
+    // Program activity (idle programs skip rendering, audio thread only)
+    bool program_events_pending[RSX_MAX_PROGRAMS];  // Notes applied since the last render
+    int program_quiet_frames[RSX_MAX_PROGRAMS];     // Frames the idle FX chain has stayed silent
+
+    // Aux bus tails: frames the shared buses keep running after their sends stop
+    int delay_bus_tail;
+    int reverb_bus_tail;
+
     // Note suppression state
     bool note_suppressed[128][RSX_MAX_PROGRAMS + 1];  // [note][program] (0=global, 1-128=programs)
 
+    // Background program loader (see samplecrate_engine_reload_program)
+    EngineLoader* loader;
+    EngineKitLoad* kit_load;                     // Kit load in progress (UI thread)
+    void (*load_progress_callback)(int loaded, int total, void* userdata);
+    void* load_progress_userdata;
+    int audio_running;                           // Audio callbacks may run (UI thread, see set_audio_running)
+    int render_programs;                         // Programs rendered per block, set with each synth swap
+
     // Current state
     int current_program;
-    std::string error_message;
+    int pending_program;        // Program switch for the audio thread, -1 = none (see switch_program)
+    int failed_program;         // Last program that failed to load, -1 = none (atomic, see get_failed_program)
 } SamplecrateEngine;
 
 // Engine lifecycle
@@ -45,23 +117,101 @@ SamplecrateEngine* samplecrate_engine_create(MednessSequencer* sequencer);
 void samplecrate_engine_destroy(SamplecrateEngine* engine);
 
 // File loading
+// Load an RSX and all its programs, building programs in parallel (blocking;
+// the audio thread must be stopped). On failure the current kit stays.
 int samplecrate_engine_load_rsx(SamplecrateEngine* engine, const char* rsx_path);
+// Same, in the background while the current kit keeps playing: programs build
+// on a pool of threads, and the audio thread swaps in the whole kit at once
+// when every program is ready. Returns 0 once started, -1 if a load is busy.
+int samplecrate_engine_load_rsx_async(SamplecrateEngine* engine, const char* rsx_path);
+// Drive an async load from the UI thread (every frame). Adopts the new RSX
+// once the kit is swapped in (DONE); if audio isn't running, installs it here.
+SamplecrateKitLoadState samplecrate_engine_poll_rsx_load(SamplecrateEngine* engine);
+// Tell the engine whether audio callbacks can run (UI thread): set before the
+// device starts, clear once it is paused or closed. While clear, kit loads
+// are installed by samplecrate_engine_poll_rsx_load instead of the audio thread.
+void samplecrate_engine_set_audio_running(SamplecrateEngine* engine, int running);
+// Progress of kit loads: programs built so far out of total. Called from the
+// loading threads (one call at a time), so keep it short.
+void samplecrate_engine_set_load_progress_callback(SamplecrateEngine* engine,
+                                                   void (*callback)(int loaded, int total, void* userdata),
+                                                   void* userdata);
+// Reload one program in the background: the new synth is built on the loader
+// thread and swapped in by the audio thread at the start of a block, while the
+// old one keeps playing until then (and stays if the load fails). Returns 0
+// once queued; repeated requests for a program collapse into the latest.
 int samplecrate_engine_reload_program(SamplecrateEngine* engine, int program_idx);
+// Block until every queued reload has been built and published
+void samplecrate_engine_wait_for_loads(SamplecrateEngine* engine);
+// Program (0-based) whose last load failed, or -1 if the latest load succeeded.
+// Safe from the UI thread while loads run; the caller formats the message.
+int samplecrate_engine_get_failed_program(SamplecrateEngine* engine);
 void samplecrate_engine_load_note_suppression(SamplecrateEngine* engine);
 void samplecrate_engine_save_note_suppression(SamplecrateEngine* engine);
 
 // Program switching
+// Make program_idx the current program. Lock-free, from any thread: the audio
+// thread switches the current synth at its next samplecrate_engine_drain_events.
 void samplecrate_engine_switch_program(SamplecrateEngine* engine, int program_idx);
 
 // Effects management
 void samplecrate_engine_autosave_effects(SamplecrateEngine* engine);
+void samplecrate_engine_apply_send_settings(SamplecrateEngine* engine);
+// Apply the RSX mix: program volumes/pans, FX enables, send settings and FX chains
+void samplecrate_engine_apply_rsx_mix(SamplecrateEngine* engine);
+// Apply RSX effects settings to an FX chain
+void samplecrate_engine_apply_rsx_effects(RegrooveEffects* fx, const RSXEffectsSettings* rsx_fx);
+
+// Get a program's FX chain, creating it on first use (never call from the audio thread)
+RegrooveEffects* samplecrate_engine_ensure_program_effects(SamplecrateEngine* engine, int program_idx);
+
+// Note events (lock-free)
+// Queue a note for the audio thread from any thread. program: 0-based
+// program index, or -1 for the current synth. Returns 0, or -1 if dropped.
+int samplecrate_engine_queue_note(SamplecrateEngine* engine, int program, int note, int velocity, int on);
+// Same, for sequenced events: frame_offset is the frame within the next
+// rendered block where the note starts (passed to sfizz as its delay)
+int samplecrate_engine_queue_note_at(SamplecrateEngine* engine, int program, int note, int velocity, int on,
+                                     int frame_offset);
+// Same, for live input: timestamp_us is when the note was played (host clock of
+// midi_get_time_us()). It sounds exactly live_latency_frames later, so latency
+// is constant instead of depending on where the audio callback happens to be.
+int samplecrate_engine_queue_note_timed(SamplecrateEngine* engine, int program, int note, int velocity, int on,
+                                        uint64_t timestamp_us);
+// Set the fixed latency of timed notes (normally one audio buffer)
+void samplecrate_engine_set_live_latency(SamplecrateEngine* engine, int latency_frames);
+// Apply all queued note events to the synths (audio thread, start of block)
+// block_frames: frames of the first render call that follows (bounds the delays)
+// block_time_us: host time at the start of this block (for timed notes)
+void samplecrate_engine_drain_events(SamplecrateEngine* engine, int block_frames, uint64_t block_time_us);
 
 // Audio rendering
+// Size the scratch arena for blocks of up to max_frames, and set up the synths
+// (loaded and loaded later) to render blocks that long (call before starting audio)
+int samplecrate_engine_prepare_audio(SamplecrateEngine* engine, int max_frames);
+// Render the full mix: program synths, per-program FX, aux buses, mixer and
+// master FX. Note events are applied by samplecrate_engine_drain_events()
+// beforehand. Blocks longer than the scratch arena are rendered in slices;
+// nothing here allocates (outputs silence if prepare_audio hasn't run).
 void samplecrate_engine_render_audio(SamplecrateEngine* engine, float* left, float* right, int num_frames);
+// Same, into interleaved stereo (L R L R ...)
+void samplecrate_engine_render_audio_interleaved(SamplecrateEngine* engine, float* out, int num_frames);
+// Render programs on num_threads threads: the audio thread plus num_threads - 1
+// workers (1 or less = audio thread only). Not safe while audio is rendering:
+// call before starting audio or with the audio callback locked out.
+int samplecrate_engine_set_render_threads(SamplecrateEngine* engine, int num_threads);
+int samplecrate_engine_get_render_threads(SamplecrateEngine* engine);
 
 // Load pads from RSX (called from UI after RSX is loaded)
 // visual_feedback_callback: optional callback for UI visual feedback (receives pad_index in userdata)
 void samplecrate_engine_load_pads(SamplecrateEngine* engine,
                                    void (*visual_feedback_callback)(int pad_index, int note, int velocity, int on));
 
+// Real-time allocation guard: with SAMPLECRATE_RT_ALLOC_GUARD defined, any
+// operator new (and, on glibc, malloc/calloc/realloc/aligned allocation)
+// between begin/end on the same thread trips an assertion. Calls nest.
+// Without it these are no-ops.
+void samplecrate_rt_guard_begin(void);
+void samplecrate_rt_guard_end(void);
+
 #endif // SAMPLECRATE_ENGINE_H
@@ -0,0 +1,62 @@
+#include "samplecrate_event_queue.h"
+#include <string.h>
+
+// Bounded multi-producer queue with a per-cell turn counter: a cell is free
+// for the producer claiming position p when sequence == p, and holds a
+// published event for the consumer when sequence == p + 1. Producers claim
+// positions with a compare-and-swap, so no thread ever waits on another.
+
+#define QUEUE_MASK (SAMPLECRATE_EVENT_QUEUE_SIZE - 1)
+
+void samplecrate_event_queue_init(SamplecrateEventQueue* queue) {
+    if (!queue) return;
+
+    memset(queue, 0, sizeof(*queue));
+    for (uint32_t i = 0; i < SAMPLECRATE_EVENT_QUEUE_SIZE; i++) {
+        queue->cells[i].sequence = i;
+    }
+}
+
+int samplecrate_event_queue_push(SamplecrateEventQueue* queue, const SamplecrateEvent* event) {
+    if (!queue || !event) return -1;
+
+    uint32_t pos = __atomic_load_n(&queue->enqueue_pos, __ATOMIC_RELAXED);
+    for (;;) {
+        SamplecrateEventCell* cell = &queue->cells[pos & QUEUE_MASK];
+        uint32_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        int32_t diff = (int32_t)(seq - pos);
+
+        if (diff == 0) {
+            // Cell is free: try to claim this position
+            if (__atomic_compare_exchange_n(&queue->enqueue_pos, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                cell->event = *event;
+                __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+                return 0;
+            }
+            // pos was reloaded by the failed compare-and-swap
+        } else if (diff < 0) {
+            // Consumer has not freed this cell yet: queue is full
+            __atomic_fetch_add(&queue->dropped, 1, __ATOMIC_RELAXED);
+            return -1;
+        } else {
+            // Another producer claimed it first
+            pos = __atomic_load_n(&queue->enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+int samplecrate_event_queue_pop(SamplecrateEventQueue* queue, SamplecrateEvent* event_out) {
+    if (!queue || !event_out) return 0;
+
+    uint32_t pos = queue->dequeue_pos;
+    SamplecrateEventCell* cell = &queue->cells[pos & QUEUE_MASK];
+    uint32_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+    if ((int32_t)(seq - (pos + 1)) < 0) return 0;  // Not published yet
+
+    *event_out = cell->event;
+    // Hand the cell back to producers for the next lap
+    __atomic_store_n(&cell->sequence, pos + SAMPLECRATE_EVENT_QUEUE_SIZE, __ATOMIC_RELEASE);
+    queue->dequeue_pos = pos + 1;
+    return 1;
+}
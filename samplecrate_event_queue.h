@@ -0,0 +1,55 @@
+#ifndef SAMPLECRATE_EVENT_QUEUE_H
+#define SAMPLECRATE_EVENT_QUEUE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Queue capacity in events (must be a power of two)
+#define SAMPLECRATE_EVENT_QUEUE_SIZE 256
+
+// Event types
+#define SAMPLECRATE_EVENT_NOTE_OFF 0
+#define SAMPLECRATE_EVENT_NOTE_ON  1
+
+// Synth event passed from control threads (MIDI, UI, sequencer) to the audio thread
+typedef struct {
+    uint8_t type;       // SAMPLECRATE_EVENT_*
+    uint8_t note;       // MIDI note number (0-127)
+    uint8_t velocity;   // MIDI velocity (0-127)
+    uint8_t reserved;
+    int32_t delay;      // Frame offset into the block that applies it (0 = block start)
+    uint64_t timestamp_us; // Host time the event was played (live input), 0 = use delay
+} SamplecrateEvent;
+
+typedef struct {
+    SamplecrateEvent event;
+    uint32_t sequence;  // Cell turn counter (see samplecrate_event_queue.c)
+} SamplecrateEventCell;
+
+// Bounded lock-free queue: any number of producers, one consumer (audio thread)
+typedef struct {
+    SamplecrateEventCell cells[SAMPLECRATE_EVENT_QUEUE_SIZE];
+    uint32_t enqueue_pos;   // Next slot to claim (producers)
+    uint32_t dequeue_pos;   // Next slot to read (consumer only)
+    uint32_t dropped;       // Events lost because the queue was full
+} SamplecrateEventQueue;
+
+// Reset queue to empty (not thread-safe: call before producers/consumer start)
+void samplecrate_event_queue_init(SamplecrateEventQueue* queue);
+
+// Push an event (any thread, never blocks)
+// Returns 0 on success, -1 if the queue is full (event dropped)
+int samplecrate_event_queue_push(SamplecrateEventQueue* queue, const SamplecrateEvent* event);
+
+// Pop the oldest event (consumer thread only)
+// Returns 1 if an event was written to event_out, 0 if the queue is empty
+int samplecrate_event_queue_pop(SamplecrateEventQueue* queue, SamplecrateEvent* event_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SAMPLECRATE_EVENT_QUEUE_H
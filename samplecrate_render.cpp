@@ -0,0 +1,377 @@
+// samplecrate-render: headless offline renderer
+// Bounces an RSX kit playing one of its sequences (or a MIDI file) to a WAV
+// file through the same engine render path as the live app, faster than real
+// time and without SDL, GL or an audio device.
+
+#include "samplecrate_engine.h"
+#include "medness_sequencer.h"
+#include "medness_performance.h"
+#include "medness_track.h"
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+
+#define RENDER_SAMPLE_RATE 44100
+#define RENDER_DEFAULT_BLOCK 512
+#define RENDER_DEFAULT_TAIL 2.0
+#define RENDER_DEFAULT_BPM 125.0f
+
+struct RenderState {
+    SamplecrateEngine* engine;
+    int midi_program;                              // Target program of a --midi file
+    unsigned char held[RSX_MAX_PROGRAMS + 1][128]; // Notes on (per queue) for release at the end
+};
+
+static RenderState render_state;
+
+static void render_queue_note(int program, int note, int velocity, int on, int frame_offset) {
+    int queue = (program < 0) ? RSX_MAX_PROGRAMS : program;
+    if (queue > RSX_MAX_PROGRAMS || note < 0 || note > 127) return;
+
+    if (on && velocity > 0) {
+        if (render_state.held[queue][note] < 255) render_state.held[queue][note]++;
+    } else if (render_state.held[queue][note] > 0) {
+        render_state.held[queue][note]--;
+    }
+    samplecrate_engine_queue_note_at(render_state.engine, program, note, velocity, on, frame_offset);
+}
+
+// Sequence events (userdata: SequenceMIDIContext)
+static void render_sequence_callback(int note, int velocity, int on, int frame_offset, void* userdata) {
+    SequenceMIDIContext* ctx = (SequenceMIDIContext*)userdata;
+    int program = (ctx && ctx->program >= 0) ? ctx->program : render_state.engine->current_program;
+    render_queue_note(program, note, velocity, on, frame_offset);
+}
+
+// MIDI file events
+static void render_midi_callback(int note, int velocity, int on, int frame_offset, void* userdata) {
+    render_queue_note(render_state.midi_program, note, velocity, on, frame_offset);
+}
+
+// Release every note still held when playback stops
+static void render_release_held(void) {
+    for (int queue = 0; queue <= RSX_MAX_PROGRAMS; queue++) {
+        int program = (queue == RSX_MAX_PROGRAMS) ? -1 : queue;
+        for (int note = 0; note < 128; note++) {
+            if (render_state.held[queue][note] > 0) {
+                samplecrate_engine_queue_note_at(render_state.engine, program, note, 0, 0, 0);
+                render_state.held[queue][note] = 0;
+            }
+        }
+    }
+}
+
+// WAV output (32-bit float or 16-bit PCM, stereo)
+static void write_u16(FILE* f, uint16_t v) {
+    unsigned char b[2] = { (unsigned char)(v & 0xFF), (unsigned char)(v >> 8) };
+    fwrite(b, 1, 2, f);
+}
+
+static void write_u32(FILE* f, uint32_t v) {
+    unsigned char b[4] = { (unsigned char)(v & 0xFF), (unsigned char)((v >> 8) & 0xFF),
+                           (unsigned char)((v >> 16) & 0xFF), (unsigned char)(v >> 24) };
+    fwrite(b, 1, 4, f);
+}
+
+// Float WAV needs the extended fmt chunk and a fact chunk
+static uint32_t wav_fmt_size(bool pcm16) { return pcm16 ? 16 : 18; }
+static uint32_t wav_fact_size(bool pcm16) { return pcm16 ? 0 : 12; }
+
+// Longest output whose sizes still fit the header's 32-bit fields (just under 4 GiB)
+static int64_t wav_max_frames(bool pcm16) {
+    uint64_t block_align = pcm16 ? 4 : 8;
+    uint64_t riff_overhead = 4 + (8 + wav_fmt_size(pcm16)) + wav_fact_size(pcm16) + 8;
+    return (int64_t)((UINT32_MAX - riff_overhead) / block_align);
+}
+
+// Write the WAV header for 'frames' frames (called again at the end with the real count)
+// 'frames' must not exceed wav_max_frames()
+static void write_wav_header(FILE* f, uint32_t frames, bool pcm16) {
+    uint16_t bits = pcm16 ? 16 : 32;
+    uint16_t block_align = 2 * bits / 8;
+    uint32_t data_bytes = frames * block_align;
+    uint32_t fmt_size = wav_fmt_size(pcm16);
+    uint32_t fact_size = wav_fact_size(pcm16);
+
+    fseek(f, 0, SEEK_SET);
+    fwrite("RIFF", 1, 4, f);
+    write_u32(f, 4 + (8 + fmt_size) + fact_size + (8 + data_bytes));
+    fwrite("WAVE", 1, 4, f);
+
+    fwrite("fmt ", 1, 4, f);
+    write_u32(f, fmt_size);
+    write_u16(f, pcm16 ? 1 : 3);  // PCM / IEEE float
+    write_u16(f, 2);
+    write_u32(f, RENDER_SAMPLE_RATE);
+    write_u32(f, RENDER_SAMPLE_RATE * block_align);
+    write_u16(f, block_align);
+    write_u16(f, bits);
+    if (!pcm16) {
+        write_u16(f, 0);  // cbSize
+        fwrite("fact", 1, 4, f);
+        write_u32(f, 4);
+        write_u32(f, frames);
+    }
+
+    fwrite("data", 1, 4, f);
+    write_u32(f, data_bytes);
+}
+
+static void print_usage(const char* prog) {
+    std::cerr << "Usage: " << prog << " <kit.rsx> -o <out.wav> [options]\n"
+              << "\n"
+              << "Source (one of):\n"
+              << "  --sequence N     Play sequence N (1-based) from the RSX\n"
+              << "  --midi FILE      Play a MIDI file\n"
+              << "  --program P      Program (1-based) for --midi (default 1)\n"
+              << "\n"
+              << "Length (default: one loop of the sequence's first phrase / the MIDI file):\n"
+              << "  --bars N         Render N bars\n"
+              << "  --seconds S      Render S seconds\n"
+              << "  --tail S         Extra seconds after the end for releases and FX tails (default "
+              << RENDER_DEFAULT_TAIL << ")\n"
+              << "\n"
+              << "Other:\n"
+              << "  --bpm B          Tempo (default " << RENDER_DEFAULT_BPM << ")\n"
+              << "  --block N        Render block size in frames (default " << RENDER_DEFAULT_BLOCK << ")\n"
+              << "  --threads N      Render programs on N threads (default 1)\n"
+              << "  --pcm16          Write 16-bit PCM instead of 32-bit float\n";
+}
+
+// Everything main() creates; render_finish() releases it on every exit path
+struct RenderSession {
+    MednessSequencer* sequencer;
+    SamplecrateEngine* engine;
+    MednessPerformance* sequences;
+    MednessTrack* midi_track;
+    FILE* out;
+};
+
+static int render_finish(RenderSession* session, int status) {
+    if (session->out) fclose(session->out);
+    if (session->sequences) medness_performance_destroy(session->sequences);
+    samplecrate_engine_destroy(session->engine);
+    if (session->midi_track) medness_track_destroy(session->midi_track);
+    medness_sequencer_destroy(session->sequencer);
+    return status;
+}
+
+int main(int argc, char* argv[]) {
+    const char* rsx_path = nullptr;
+    const char* out_path = nullptr;
+    const char* midi_path = nullptr;
+    int sequence_number = 0;
+    int program_number = 1;
+    double bars = 0.0;
+    double seconds = 0.0;
+    double tail_seconds = RENDER_DEFAULT_TAIL;
+    float bpm = RENDER_DEFAULT_BPM;
+    int block_frames = RENDER_DEFAULT_BLOCK;
+    int render_threads = 1;
+    bool pcm16 = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool has_value = (i + 1 < argc);
+        if ((strcmp(arg, "-o") == 0 || strcmp(arg, "--output") == 0) && has_value) {
+            out_path = argv[++i];
+        } else if (strcmp(arg, "--sequence") == 0 && has_value) {
+            sequence_number = atoi(argv[++i]);
+        } else if (strcmp(arg, "--midi") == 0 && has_value) {
+            midi_path = argv[++i];
+        } else if (strcmp(arg, "--program") == 0 && has_value) {
+            program_number = atoi(argv[++i]);
+        } else if (strcmp(arg, "--bars") == 0 && has_value) {
+            bars = atof(argv[++i]);
+        } else if (strcmp(arg, "--seconds") == 0 && has_value) {
+            seconds = atof(argv[++i]);
+        } else if (strcmp(arg, "--tail") == 0 && has_value) {
+            tail_seconds = atof(argv[++i]);
+        } else if (strcmp(arg, "--bpm") == 0 && has_value) {
+            bpm = (float)atof(argv[++i]);
+        } else if (strcmp(arg, "--block") == 0 && has_value) {
+            block_frames = atoi(argv[++i]);
+        } else if (strcmp(arg, "--threads") == 0 && has_value) {
+            render_threads = atoi(argv[++i]);
+        } else if (strcmp(arg, "--pcm16") == 0) {
+            pcm16 = true;
+        } else if (arg[0] != '-' && !rsx_path) {
+            rsx_path = arg;
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!rsx_path || !out_path || (sequence_number <= 0) == (midi_path == nullptr)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (program_number < 1 || program_number > RSX_MAX_PROGRAMS || bpm <= 0.0f || block_frames <= 0 ||
+        tail_seconds < 0.0) {
+        std::cerr << "[RENDER] Invalid option value" << std::endl;
+        return 1;
+    }
+
+    // Engine and sequencer, as in the app but driven by this loop
+    RenderSession session = {};
+    MednessSequencer* sequencer = medness_sequencer_create();
+    session.sequencer = sequencer;
+    medness_sequencer_set_bpm(sequencer, bpm);
+    medness_sequencer_set_active(sequencer, 1);
+
+    SamplecrateEngine* engine = samplecrate_engine_create(sequencer);
+    session.engine = engine;
+    if (!engine || samplecrate_engine_prepare_audio(engine, block_frames) != 0) {
+        std::cerr << "[RENDER] Failed to create engine" << std::endl;
+        return render_finish(&session, 1);
+    }
+    samplecrate_engine_set_render_threads(engine, render_threads);
+    render_state.engine = engine;
+    render_state.midi_program = program_number - 1;
+    memset(render_state.held, 0, sizeof(render_state.held));
+
+    if (samplecrate_engine_load_rsx(engine, rsx_path) != 0) {
+        std::cerr << "[RENDER] Failed to load RSX: " << rsx_path << std::endl;
+        return render_finish(&session, 1);
+    }
+    samplecrate_engine_apply_rsx_mix(engine);
+
+    // Source
+    MednessPerformance* sequences = nullptr;
+    MednessTrack* midi_track = nullptr;
+    int slot = 0;
+
+    if (midi_path) {
+        midi_track = medness_track_create();
+        session.midi_track = midi_track;
+        if (medness_track_load_midi_file(midi_track, midi_path) != 0) {
+            std::cerr << "[RENDER] Failed to load MIDI file: " << midi_path << std::endl;
+            return render_finish(&session, 1);
+        }
+        medness_sequencer_add_track(sequencer, slot, midi_track, render_midi_callback, nullptr);
+    } else {
+        int seq_index = sequence_number - 1;
+        sequences = medness_performance_create();
+        session.sequences = sequences;
+        medness_performance_set_sequencer(sequences, sequencer);
+        medness_performance_set_midi_callback(sequences, render_sequence_callback, nullptr);
+        medness_performance_set_tempo(sequences, bpm);
+        medness_performance_set_start_mode(sequences, SEQUENCE_START_IMMEDIATE);
+        medness_performance_load_from_rsx(sequences, rsx_path, engine->rsx);
+
+        MednessSequence* player = medness_performance_get_player(sequences, seq_index);
+        if (!player) {
+            std::cerr << "[RENDER] Sequence " << sequence_number << " not found (or disabled/empty)" << std::endl;
+            return render_finish(&session, 1);
+        }
+        medness_performance_play(sequences, seq_index, 0);
+        slot = medness_sequence_get_slot(player);
+    }
+
+    // Length (after taking over the kit's meter and the sequence's loop length)
+    medness_sequencer_update(sequencer, 0, RENDER_SAMPLE_RATE);
+    double frames_per_pulse = RENDER_SAMPLE_RATE * 60.0 / (bpm * 24.0);
+    int64_t length_frames;
+    if (seconds > 0.0) {
+        length_frames = (int64_t)(seconds * RENDER_SAMPLE_RATE + 0.5);
+    } else if (bars > 0.0) {
+        int beats_per_bar = 4;
+        int beat_unit = 4;
+        medness_sequencer_get_time_signature(sequencer, &beats_per_bar, &beat_unit);
+        double bar_pulses = beats_per_bar * 96.0 / beat_unit;
+        length_frames = (int64_t)(bars * bar_pulses * frames_per_pulse + 0.5);
+    } else {
+        length_frames = (int64_t)(medness_sequencer_get_slot_loop_length(sequencer, slot) * frames_per_pulse + 0.5);
+    }
+    int64_t tail_frames = (int64_t)(tail_seconds * RENDER_SAMPLE_RATE + 0.5);
+    int64_t total_frames = length_frames + tail_frames;
+    if (total_frames > wav_max_frames(pcm16)) {
+        std::cerr << "[RENDER] Output too long for a WAV file (over 4 GiB)" << std::endl;
+        return render_finish(&session, 1);
+    }
+
+    FILE* out = fopen(out_path, "wb");
+    session.out = out;
+    if (!out) {
+        std::cerr << "[RENDER] Cannot write " << out_path << std::endl;
+        return render_finish(&session, 1);
+    }
+    write_wav_header(out, 0, pcm16);
+
+    std::cout << "[RENDER] " << rsx_path << " -> " << out_path << ": "
+              << (double)length_frames / RENDER_SAMPLE_RATE << "s + "
+              << tail_seconds << "s tail at " << bpm << " BPM" << std::endl;
+
+    std::vector<float> left(block_frames);
+    std::vector<float> right(block_frames);
+    std::vector<float> interleaved((size_t)block_frames * 2);
+    std::vector<int16_t> pcm((size_t)block_frames * 2);
+
+    auto start_time = std::chrono::steady_clock::now();
+    bool stopped = false;
+    int64_t done = 0;
+    while (done < total_frames) {
+        int64_t remaining = (done < length_frames ? length_frames : total_frames) - done;
+        int n = remaining < block_frames ? (int)remaining : block_frames;
+
+        // End of the material: stop playback and let the tails ring out
+        if (!stopped && done >= length_frames) {
+            if (sequences) medness_performance_stop_all(sequences);
+            medness_sequencer_remove_track(sequencer, slot);
+            render_release_held();
+            stopped = true;
+        }
+
+        medness_sequencer_update(sequencer, n, RENDER_SAMPLE_RATE);
+        if (sequences) {
+            medness_performance_update_samples(sequences, n, RENDER_SAMPLE_RATE,
+                                               medness_sequencer_get_pulse(sequencer));
+        }
+        samplecrate_engine_drain_events(engine, n, 0);
+        samplecrate_engine_render_audio(engine, left.data(), right.data(), n);
+
+        if (pcm16) {
+            for (int i = 0; i < n; i++) {
+                float l = left[i] < -1.0f ? -1.0f : (left[i] > 1.0f ? 1.0f : left[i]);
+                float r = right[i] < -1.0f ? -1.0f : (right[i] > 1.0f ? 1.0f : right[i]);
+                pcm[i * 2] = (int16_t)(l * 32767.0f);
+                pcm[i * 2 + 1] = (int16_t)(r * 32767.0f);
+            }
+            if (fwrite(pcm.data(), sizeof(int16_t), (size_t)n * 2, out) != (size_t)n * 2) break;
+        } else {
+            for (int i = 0; i < n; i++) {
+                interleaved[i * 2] = left[i];
+                interleaved[i * 2 + 1] = right[i];
+            }
+            if (fwrite(interleaved.data(), sizeof(float), (size_t)n * 2, out) != (size_t)n * 2) break;
+        }
+        done += n;
+    }
+
+    // A short write (e.g. full disk) ends the loop early; report it instead
+    // of leaving a truncated WAV behind a success status
+    bool written = (done == total_frames);
+    if (written) {
+        write_wav_header(out, (uint32_t)total_frames, pcm16);
+        written = !ferror(out);
+    }
+    session.out = nullptr;
+    if (fclose(out) != 0) written = false;
+    if (!written) {
+        std::cerr << "[RENDER] Failed to write " << out_path << std::endl;
+        return render_finish(&session, 1);
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    double rendered = (double)total_frames / RENDER_SAMPLE_RATE;
+    std::cout << "[RENDER] Wrote " << rendered << "s in " << elapsed << "s";
+    if (elapsed > 0.0) std::cout << " (" << rendered / elapsed << "x real time)";
+    std::cout << std::endl;
+
+    return render_finish(&session, 0);
+}
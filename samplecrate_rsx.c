@@ -88,6 +88,8 @@ SamplecrateRSX* samplecrate_rsx_create(void) {
         rsx->program_names[i][0] = '\0';
         rsx->program_volumes[i] = 1.0f;  // Default volume (100%)
         rsx->program_pans[i] = 0.5f;     // Center pan
+        rsx->program_delay_sends[i] = 0.0f;  // No aux sends by default
+        rsx->program_reverb_sends[i] = 0.0f;
         rsx->program_midi_channels[i] = -1;  // Omni (all channels) by default
         rsx->program_modes[i] = PROGRAM_MODE_SFZ_FILE;  // Default to SFZ file mode
         rsx->program_sample_counts[i] = 0;  // No samples initially
@@ -102,7 +104,16 @@ SamplecrateRSX* samplecrate_rsx_create(void) {
         rsx->sequences[i].enabled = 1;
         rsx->sequences[i].loop = 1;  // Default: loop sequence
         rsx->sequences[i].slot = -1;  // -1 = not an uploaded sequence
+        rsx->sequences[i].midi_output_channel = -1;  // -1 = internal synths
+        rsx->sequences[i].loop_length = 0;  // 0 = follow the track length
+        rsx->sequences[i].swing = -1.0f;  // -1 = kit swing
+        memset(&rsx->sequences[i].groove, 0, sizeof(RSXGroove));  // No groove of its own
     }
+    rsx->beats_per_bar = 4;  // 4/4, 4-bar patterns, straight
+    rsx->beat_unit = 4;
+    rsx->pattern_bars = 4;
+    rsx->swing = 0.0f;
+    memset(&rsx->groove, 0, sizeof(RSXGroove));
 
     // Initialize FX chain enables (default ON)
     rsx->master_fx_enable = 1;
@@ -115,6 +126,9 @@ SamplecrateRSX* samplecrate_rsx_create(void) {
     for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
         init_effects_defaults(&rsx->program_effects[i]);
     }
+    init_effects_defaults(&rsx->send_effects);
+    rsx->delay_return = 1.0f;
+    rsx->reverb_return = 1.0f;
 
     // Initialize pads
     for (int i = 0; i < RSX_MAX_NOTE_PADS; i++) {
@@ -197,6 +211,32 @@ static int parse_key_value(const char* line, char* key, char* value, size_t key_
     return 0;
 }
 
+// Helper: load a groove template setting (groove_steps, or comma-separated
+// groove_timing/groove_velocity lists)
+static void load_groove_setting(RSXGroove* groove, const char* key, const char* value) {
+    if (!groove || !key || !value) return;
+
+    if (strcmp(key, "groove_steps") == 0) {
+        int steps = atoi(value);
+        if (steps < 0) steps = 0;
+        if (steps > RSX_MAX_GROOVE_STEPS) steps = RSX_MAX_GROOVE_STEPS;
+        groove->steps = steps;
+    } else if (strcmp(key, "groove_timing") == 0 || strcmp(key, "groove_velocity") == 0) {
+        int is_timing = (key[7] == 't');
+        const char* p = value;
+        for (int i = 0; i < RSX_MAX_GROOVE_STEPS && *p != '\0'; i++) {
+            if (is_timing) {
+                groove->timing[i] = (float)atof(p);
+            } else {
+                groove->velocity[i] = atoi(p);
+            }
+            p = strchr(p, ',');
+            if (!p) break;
+            p++;
+        }
+    }
+}
+
 // Helper: load effects settings from key-value pairs
 static void load_effects_setting(RSXEffectsSettings* fx, const char* key, const char* value) {
     if (!fx || !key || !value) return;
@@ -260,6 +300,8 @@ int samplecrate_rsx_load(SamplecrateRSX* rsx, const char* filepath) {
         rsx->program_names[i][0] = '\0';
         rsx->program_volumes[i] = 1.0f;
         rsx->program_pans[i] = 0.5f;
+        rsx->program_delay_sends[i] = 0.0f;
+        rsx->program_reverb_sends[i] = 0.0f;
         rsx->program_midi_channels[i] = -1;
         rsx->program_modes[i] = PROGRAM_MODE_SFZ_FILE;
         rsx->program_sample_counts[i] = 0;
@@ -278,6 +320,9 @@ int samplecrate_rsx_load(SamplecrateRSX* rsx, const char* filepath) {
     for (int i = 0; i < RSX_MAX_PROGRAMS; i++) {
         init_effects_defaults(&rsx->program_effects[i]);
     }
+    init_effects_defaults(&rsx->send_effects);
+    rsx->delay_return = 1.0f;
+    rsx->reverb_return = 1.0f;
 
     // Reset pads
     for (int i = 0; i < RSX_MAX_NOTE_PADS; i++) {
@@ -306,7 +351,16 @@ int samplecrate_rsx_load(SamplecrateRSX* rsx, const char* filepath) {
         rsx->sequences[i].loop = 1;
         rsx->sequences[i].program_number = 0;
         rsx->sequences[i].slot = -1;
+        rsx->sequences[i].midi_output_channel = -1;
+        rsx->sequences[i].loop_length = 0;
+        rsx->sequences[i].swing = -1.0f;
+        memset(&rsx->sequences[i].groove, 0, sizeof(RSXGroove));
     }
+    rsx->beats_per_bar = 4;
+    rsx->beat_unit = 4;
+    rsx->pattern_bars = 4;
+    rsx->swing = 0.0f;
+    memset(&rsx->groove, 0, sizeof(RSXGroove));
 
     FILE* f = fopen(filepath, "r");
     if (!f) {
@@ -383,6 +437,12 @@ int samplecrate_rsx_load(SamplecrateRSX* rsx, const char* filepath) {
                         // prog_N_pan (but NOT prog_N_sample_M_pan)
                         rsx->program_pans[prog_idx] = atof(value);
                         printf("DEBUG: Stored program %d pan: %.3f\n", prog_num, rsx->program_pans[prog_idx]);
+                    } else if (strstr(key, "_delay_send") != NULL) {
+                        // prog_N_delay_send
+                        rsx->program_delay_sends[prog_idx] = atof(value);
+                    } else if (strstr(key, "_reverb_send") != NULL) {
+                        // prog_N_reverb_send
+                        rsx->program_reverb_sends[prog_idx] = atof(value);
                     } else if (strstr(key, "_fx_enable") != NULL) {
                         // prog_N_fx_enable
                         rsx->program_fx_enable[prog_idx] = atoi(value);
@@ -440,6 +500,23 @@ int samplecrate_rsx_load(SamplecrateRSX* rsx, const char* filepath) {
                 }
             }
         }
+        // Handle [Sequencer] section (case-insensitive)
+        else if (strcasecmp(section, "Sequencer") == 0) {
+            if (strcmp(key, "time_signature") == 0) {
+                int beats = 0, unit = 0;
+                if (sscanf(value, "%d/%d", &beats, &unit) == 2 && beats > 0 && unit > 0) {
+                    rsx->beats_per_bar = beats;
+                    rsx->beat_unit = unit;
+                }
+            } else if (strcmp(key, "pattern_bars") == 0) {
+                int bars = atoi(value);
+                if (bars > 0) rsx->pattern_bars = bars;
+            } else if (strcmp(key, "swing") == 0) {
+                rsx->swing = atof(value);
+            } else {
+                load_groove_setting(&rsx->groove, key, value);
+            }
+        }
         // Handle [MasterEffects] section (case-insensitive)
         else if (strcasecmp(section, "MasterEffects") == 0) {
             if (strcmp(key, "fx_enable") == 0) {
@@ -448,6 +525,16 @@ int samplecrate_rsx_load(SamplecrateRSX* rsx, const char* filepath) {
                 load_effects_setting(&rsx->master_effects, key, value);
             }
         }
+        // Handle [SendEffects] section (shared delay/reverb buses)
+        else if (strcasecmp(section, "SendEffects") == 0) {
+            if (strcmp(key, "delay_return") == 0) {
+                rsx->delay_return = atof(value);
+            } else if (strcmp(key, "reverb_return") == 0) {
+                rsx->reverb_return = atof(value);
+            } else {
+                load_effects_setting(&rsx->send_effects, key, value);
+            }
+        }
         // Handle [ProgramEffects1-4] sections (case-insensitive)
         else if (strncasecmp(section, "ProgramEffects", 14) == 0) {
             int prog_num = atoi(section + 14);  // Extract number from "ProgramEffects1" etc.
@@ -512,6 +599,15 @@ int samplecrate_rsx_load(SamplecrateRSX* rsx, const char* filepath) {
                     rsx->sequences[seq_idx].program_number = atoi(value);
                 } else if (strcmp(key, "slot") == 0) {
                     rsx->sequences[seq_idx].slot = atoi(value);
+                } else if (strcmp(key, "midi_output_channel") == 0) {
+                    rsx->sequences[seq_idx].midi_output_channel = atoi(value);
+                } else if (strcmp(key, "loop_length") == 0) {
+                    int length = atoi(value);
+                    rsx->sequences[seq_idx].loop_length = (length > 0) ? length : 0;
+                } else if (strcmp(key, "swing") == 0) {
+                    rsx->sequences[seq_idx].swing = atof(value);
+                } else if (strncmp(key, "groove_", 7) == 0) {
+                    load_groove_setting(&rsx->sequences[seq_idx].groove, key, value);
                 } else if (strcmp(key, "num_phrases") == 0) {
                     rsx->sequences[seq_idx].num_phrases = atoi(value);
                     if (seq_num > rsx->num_sequences) {
@@ -600,6 +696,23 @@ int samplecrate_rsx_load(SamplecrateRSX* rsx, const char* filepath) {
     return 0;
 }
 
+// Helper: save a groove template (nothing if it has no steps)
+static void save_groove_settings(FILE* f, const RSXGroove* groove) {
+    if (!f || !groove || groove->steps <= 0) return;
+
+    fprintf(f, "groove_steps=%d\n", groove->steps);
+    fprintf(f, "groove_timing=");
+    for (int i = 0; i < groove->steps; i++) {
+        fprintf(f, "%s%.3f", (i > 0) ? "," : "", groove->timing[i]);
+    }
+    fprintf(f, "  ; Offset per 16th in 16ths (+ = late)\n");
+    fprintf(f, "groove_velocity=");
+    for (int i = 0; i < groove->steps; i++) {
+        fprintf(f, "%s%d", (i > 0) ? "," : "", groove->velocity[i]);
+    }
+    fprintf(f, "  ; Velocity offset per 16th\n");
+}
+
 // Helper: save effects settings to file with prefix
 static void save_effects_settings(FILE* f, const char* prefix, const RSXEffectsSettings* fx) {
     if (!f || !prefix || !fx) return;
@@ -680,6 +793,8 @@ int samplecrate_rsx_save(SamplecrateRSX* rsx, const char* filepath) {
             fprintf(f, "prog_%d_volume=%.3f\n", i + 1, rsx->program_volumes[i]);
             fprintf(f, "prog_%d_pan=%.3f\n", i + 1, rsx->program_pans[i]);
             fprintf(f, "prog_%d_fx_enable=%d\n", i + 1, rsx->program_fx_enable[i]);
+            fprintf(f, "prog_%d_delay_send=%.3f\n", i + 1, rsx->program_delay_sends[i]);
+            fprintf(f, "prog_%d_reverb_send=%.3f\n", i + 1, rsx->program_reverb_sends[i]);
             fprintf(f, "prog_%d_midi_channel=%d  ; -1 = Omni, 0-15 = MIDI channel 1-16\n", i + 1, rsx->program_midi_channels[i]);
 
             // Save sample data for sample-based programs
@@ -705,12 +820,30 @@ int samplecrate_rsx_save(SamplecrateRSX* rsx, const char* filepath) {
         fprintf(f, "\n");
     }
 
+    // Write sequencer timing
+    fprintf(f, "[Sequencer]\n");
+    fprintf(f, "time_signature=%d/%d\n", rsx->beats_per_bar, rsx->beat_unit);
+    fprintf(f, "pattern_bars=%d\n", rsx->pattern_bars);
+    fprintf(f, "swing=%.3f  ; 0=straight, 1=75%%\n", rsx->swing);
+    save_groove_settings(f, &rsx->groove);
+    fprintf(f, "\n");
+
     // Write master effects
     fprintf(f, "[MasterEffects]\n");
     fprintf(f, "fx_enable=%d\n", rsx->master_fx_enable);
     save_effects_settings(f, "", &rsx->master_effects);
     fprintf(f, "\n");
 
+    // Write shared aux buses
+    fprintf(f, "[SendEffects]\n");
+    fprintf(f, "delay_time=%.3f\n", rsx->send_effects.delay_time);
+    fprintf(f, "delay_feedback=%.3f\n", rsx->send_effects.delay_feedback);
+    fprintf(f, "delay_return=%.3f\n", rsx->delay_return);
+    fprintf(f, "reverb_room_size=%.3f\n", rsx->send_effects.reverb_room_size);
+    fprintf(f, "reverb_damping=%.3f\n", rsx->send_effects.reverb_damping);
+    fprintf(f, "reverb_return=%.3f\n", rsx->reverb_return);
+    fprintf(f, "\n");
+
     // Write per-program effects
     for (int i = 0; i < rsx->num_programs; i++) {
         fprintf(f, "[ProgramEffects%d]\n", i + 1);
@@ -763,6 +896,14 @@ int samplecrate_rsx_save(SamplecrateRSX* rsx, const char* filepath) {
             fprintf(f, "loop=%d  ; 1=loop sequence, 0=play once\n", seq->loop);
             fprintf(f, "program_number=%d  ; Program to target (0-3 for programs 1-4)\n", seq->program_number);
             fprintf(f, "slot=%d  ; Upload slot (0-15=remote upload, -1=manual sequence)\n", seq->slot);
+            fprintf(f, "midi_output_channel=%d  ; MIDI output channel (0-15), -1=internal synths\n", seq->midi_output_channel);
+            if (seq->loop_length > 0) {
+                fprintf(f, "loop_length=%d  ; Loop length in 16th notes\n", seq->loop_length);
+            }
+            if (seq->swing >= 0.0f) {
+                fprintf(f, "swing=%.3f  ; 0=straight, 1=75%%\n", seq->swing);
+            }
+            save_groove_settings(f, &seq->groove);
             fprintf(f, "num_phrases=%d\n", seq->num_phrases);
 
             // Write phrases
@@ -14,6 +14,7 @@ extern "C" {
 #define RSX_MAX_SAMPLES_PER_PROGRAM 64  // Max samples per program
 #define RSX_MAX_SEQUENCES 16  // Max number of sequences (tracks)
 #define RSX_MAX_PHRASES_PER_SEQUENCE 64  // Max phrases per sequence
+#define RSX_MAX_GROOVE_STEPS 32  // Max groove template length (16th notes)
 
 // Effects settings for one effects chain
 typedef struct {
@@ -79,6 +80,13 @@ typedef enum {
     PROGRAM_MODE_SAMPLES = 1      // Build from sample list
 } RSXProgramMode;
 
+// Groove template: timing and velocity offsets per 16th note
+typedef struct {
+    int steps;                          // Template length in 16ths (0 = no template)
+    float timing[RSX_MAX_GROOVE_STEPS]; // Offset in 16ths (-0.5 to 0.5, + = late)
+    int velocity[RSX_MAX_GROOVE_STEPS]; // Added to note-on velocities
+} RSXGroove;
+
 // Phrase definition for a sequence
 typedef struct {
     char midi_file[RSX_MAX_PATH];       // MIDI file path
@@ -95,6 +103,10 @@ typedef struct {
     int loop;                           // 1=loop entire sequence, 0=play once
     int program_number;                 // Program to target (0-3 for programs 1-4)
     int slot;                           // Slot number for uploaded sequences (0-15, -1 = not uploaded)
+    int midi_output_channel;            // Play on the MIDI output (0-15 for channels 1-16, -1 = internal synths)
+    int loop_length;                    // Loop length in 16th notes (0 = track length rounded up to whole bars)
+    float swing;                        // Swing (0.0-1.0, -1 = kit swing)
+    RSXGroove groove;                   // Groove template (steps 0 = kit groove)
 } RSXSequence;
 
 // Note trigger pad configuration (SONG pads - stored in .rsx files)
@@ -134,6 +146,10 @@ typedef struct {
     float program_volumes[RSX_MAX_PROGRAMS];  // Default volume for each program (0.0-1.0)
     float program_pans[RSX_MAX_PROGRAMS];     // Default pan for each program (0.0-1.0, 0.5=center)
 
+    // Per-program aux send levels (shared delay/reverb buses, 0.0-1.0)
+    float program_delay_sends[RSX_MAX_PROGRAMS];
+    float program_reverb_sends[RSX_MAX_PROGRAMS];
+
     // Per-program MIDI channel filtering (-1 = Omni/all channels, 0-15 = specific channel)
     int program_midi_channels[RSX_MAX_PROGRAMS];  // MIDI channel filter per program
 
@@ -152,6 +168,11 @@ typedef struct {
     RSXEffectsSettings master_effects;                    // Master effects chain
     RSXEffectsSettings program_effects[RSX_MAX_PROGRAMS]; // Per-program effects chains
 
+    // Shared aux buses (only delay_* and reverb_* fields of send_effects are used)
+    RSXEffectsSettings send_effects;
+    float delay_return;                      // Delay bus return level (0.0-1.0)
+    float reverb_return;                     // Reverb bus return level (0.0-1.0)
+
     NoteTriggerPad pads[RSX_MAX_NOTE_PADS];
     int num_pads;
 
@@ -159,6 +180,13 @@ typedef struct {
     RSXSequence sequences[RSX_MAX_SEQUENCES];
     int num_sequences;
 
+    // Sequencer timing
+    int beats_per_bar;                  // Time signature numerator (default 4)
+    int beat_unit;                      // Time signature denominator (default 4)
+    int pattern_bars;                   // Global pattern length in bars (default 4)
+    float swing;                        // Swing (0.0 = straight, 1.0 = 75%)
+    RSXGroove groove;                   // Groove template (steps 0 = none)
+
     // Note suppression (128 MIDI notes, 0-127)
     // [note] = global suppression (affects all programs)
     // [note] = per-program suppression for all programs
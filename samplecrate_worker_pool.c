@@ -0,0 +1,242 @@
+#include "samplecrate_worker_pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#ifdef _WIN32
+#if !defined(_WIN32_WINNT) || _WIN32_WINNT < 0x0602
+#undef _WIN32_WINNT
+#define _WIN32_WINNT 0x0602  // WaitOnAddress (Windows 8)
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Fork/join pool for the audio thread. A run publishes one packed work word
+// (generation | task count | next task index); the caller and the workers
+// claim task indices from it with compare-and-swap, and the caller spins
+// until the pending count drops to zero. Workers spin for a short while
+// after each run (blocks arrive every few milliseconds) and then sleep on a
+// futex (WaitOnAddress on Windows), so an idle pool costs nothing and a
+// busy one never takes a syscall on the audio thread unless a worker sleeps.
+
+// Worker spin iterations before sleeping (roughly 50-200 us)
+#define POOL_SPIN_ITERATIONS 4000
+
+#define WORK_GEN_SHIFT 32
+#define WORK_COUNT_SHIFT 16
+#define WORK_INDEX_MASK 0xFFFFu
+
+struct SamplecrateWorkerPool {
+    int num_workers;
+#ifdef _WIN32
+    HANDLE* threads;
+#else
+    pthread_t* threads;
+#endif
+
+    // Current run (written by the caller before the work word is published)
+    SamplecrateWorkerTask task;
+    void* ctx;
+
+    uint64_t work;        // Generation (32) | count (16) | next index (16)
+    int pending;          // Tasks of the current run not finished yet
+    uint32_t wake_seq;    // Bumped per run; workers sleep on it
+    int sleepers;         // Workers blocked (or about to block) on wake_seq
+    int quit;
+};
+
+static inline void pool_cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// Block while *addr == expected (may return spuriously)
+static void pool_wait(uint32_t* addr, uint32_t expected) {
+#if defined(__linux__)
+    syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, NULL, NULL, 0);
+#elif defined(_WIN32)
+    WaitOnAddress((volatile VOID*)addr, &expected, sizeof(expected), INFINITE);
+#else
+    // No address wait here: poll
+    (void)addr;
+    (void)expected;
+    struct timespec ts = { 0, 100000 };
+    nanosleep(&ts, NULL);
+#endif
+}
+
+static void pool_wake_all(uint32_t* addr) {
+#if defined(__linux__)
+    syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, INT32_MAX, NULL, NULL, 0);
+#elif defined(_WIN32)
+    WakeByAddressAll((PVOID)addr);
+#else
+    (void)addr;
+#endif
+}
+
+// Claim and run tasks of the current run until none are left
+static void pool_work(SamplecrateWorkerPool* pool) {
+    uint64_t work = __atomic_load_n(&pool->work, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint32_t count = (uint32_t)(work >> WORK_COUNT_SHIFT) & WORK_INDEX_MASK;
+        uint32_t index = (uint32_t)work & WORK_INDEX_MASK;
+        if (index >= count) return;
+
+        // The generation bits make a claim against a finished run fail
+        if (__atomic_compare_exchange_n(&pool->work, &work, work + 1, 1, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+            pool->task(pool->ctx, (int)index);
+            __atomic_fetch_sub(&pool->pending, 1, __ATOMIC_RELEASE);
+            work = __atomic_load_n(&pool->work, __ATOMIC_ACQUIRE);
+        }
+        // work was reloaded by the failed compare-and-swap
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI pool_worker_main(LPVOID arg) {
+#else
+static void* pool_worker_main(void* arg) {
+#endif
+    SamplecrateWorkerPool* pool = (SamplecrateWorkerPool*)arg;
+    uint32_t seen = __atomic_load_n(&pool->wake_seq, __ATOMIC_ACQUIRE);
+
+    while (!__atomic_load_n(&pool->quit, __ATOMIC_ACQUIRE)) {
+        uint32_t seq;
+        int spins = 0;
+        while ((seq = __atomic_load_n(&pool->wake_seq, __ATOMIC_ACQUIRE)) == seen) {
+            if (__atomic_load_n(&pool->quit, __ATOMIC_ACQUIRE)) break;
+            if (++spins < POOL_SPIN_ITERATIONS) {
+                pool_cpu_relax();
+                continue;
+            }
+            // Announce the sleep before re-checking, so a run that bumps
+            // wake_seq after this point sees us and wakes us
+            __atomic_fetch_add(&pool->sleepers, 1, __ATOMIC_SEQ_CST);
+            if (__atomic_load_n(&pool->wake_seq, __ATOMIC_SEQ_CST) == seen &&
+                !__atomic_load_n(&pool->quit, __ATOMIC_SEQ_CST)) {
+                pool_wait(&pool->wake_seq, seen);
+            }
+            __atomic_fetch_sub(&pool->sleepers, 1, __ATOMIC_SEQ_CST);
+            spins = 0;
+        }
+        seen = seq;
+        pool_work(pool);
+    }
+    return 0;
+}
+
+// Give workers real-time priority where allowed (silently keeps the default otherwise)
+static void pool_set_worker_priority(SamplecrateWorkerPool* pool, int index) {
+#ifdef _WIN32
+    SetThreadPriority(pool->threads[index], THREAD_PRIORITY_TIME_CRITICAL);
+#elif defined(__linux__)
+    struct sched_param param;
+    param.sched_priority = sched_get_priority_min(SCHED_FIFO) + 10;
+    pthread_setschedparam(pool->threads[index], SCHED_FIFO, &param);
+#else
+    (void)pool;
+    (void)index;
+#endif
+}
+
+SamplecrateWorkerPool* samplecrate_worker_pool_create(int num_workers) {
+    if (num_workers <= 0) return NULL;
+
+    SamplecrateWorkerPool* pool = (SamplecrateWorkerPool*)calloc(1, sizeof(SamplecrateWorkerPool));
+    if (!pool) return NULL;
+    pool->threads = calloc((size_t)num_workers, sizeof(*pool->threads));
+    if (!pool->threads) {
+        free(pool);
+        return NULL;
+    }
+
+    for (int i = 0; i < num_workers; i++) {
+#ifdef _WIN32
+        pool->threads[i] = CreateThread(NULL, 0, pool_worker_main, pool, 0, NULL);
+        int ok = (pool->threads[i] != NULL);
+#else
+        int ok = (pthread_create(&pool->threads[i], NULL, pool_worker_main, pool) == 0);
+#endif
+        if (!ok) {
+            fprintf(stderr, "[WORKERS] Failed to start worker %d\n", i);
+            pool->num_workers = i;
+            samplecrate_worker_pool_destroy(pool);
+            return NULL;
+        }
+        pool->num_workers = i + 1;
+        pool_set_worker_priority(pool, i);
+    }
+
+    printf("[WORKERS] Started %d render worker(s)\n", num_workers);
+    return pool;
+}
+
+void samplecrate_worker_pool_destroy(SamplecrateWorkerPool* pool) {
+    if (!pool) return;
+
+    __atomic_store_n(&pool->quit, 1, __ATOMIC_SEQ_CST);
+    __atomic_fetch_add(&pool->wake_seq, 1, __ATOMIC_SEQ_CST);
+    pool_wake_all(&pool->wake_seq);
+
+    for (int i = 0; i < pool->num_workers; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(pool->threads[i], INFINITE);
+        CloseHandle(pool->threads[i]);
+#else
+        pthread_join(pool->threads[i], NULL);
+#endif
+    }
+    free(pool->threads);
+    free(pool);
+}
+
+int samplecrate_worker_pool_get_workers(SamplecrateWorkerPool* pool) {
+    if (!pool) return 0;
+    return pool->num_workers;
+}
+
+void samplecrate_worker_pool_run(SamplecrateWorkerPool* pool, SamplecrateWorkerTask task, void* ctx, int count) {
+    if (!task || count <= 0) return;
+    if (count > SAMPLECRATE_WORKER_POOL_MAX_TASKS) count = SAMPLECRATE_WORKER_POOL_MAX_TASKS;
+
+    // Nothing to share: run inline
+    if (!pool || count == 1) {
+        for (int i = 0; i < count; i++) {
+            task(ctx, i);
+        }
+        return;
+    }
+
+    pool->task = task;
+    pool->ctx = ctx;
+    __atomic_store_n(&pool->pending, count, __ATOMIC_RELAXED);
+
+    // Publish the run (releases task/ctx/pending to claimers)
+    uint64_t generation = (__atomic_load_n(&pool->work, __ATOMIC_RELAXED) >> WORK_GEN_SHIFT) + 1;
+    __atomic_store_n(&pool->work, (generation << WORK_GEN_SHIFT) | ((uint64_t)count << WORK_COUNT_SHIFT),
+                     __ATOMIC_RELEASE);
+
+    // Wake spinning workers for free, sleeping ones with one syscall
+    __atomic_fetch_add(&pool->wake_seq, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&pool->sleepers, __ATOMIC_SEQ_CST) > 0) {
+        pool_wake_all(&pool->wake_seq);
+    }
+
+    // Help, then wait for tasks still running on workers
+    pool_work(pool);
+    while (__atomic_load_n(&pool->pending, __ATOMIC_ACQUIRE) > 0) {
+        pool_cpu_relax();
+    }
+}
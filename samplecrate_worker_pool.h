@@ -0,0 +1,37 @@
+#ifndef SAMPLECRATE_WORKER_POOL_H
+#define SAMPLECRATE_WORKER_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Maximum number of tasks per run
+#define SAMPLECRATE_WORKER_POOL_MAX_TASKS 65535
+
+// Task function: called once per task index, on any pool thread
+typedef void (*SamplecrateWorkerTask)(void* ctx, int task_index);
+
+typedef struct SamplecrateWorkerPool SamplecrateWorkerPool;
+
+// Create a pool of num_workers helper threads (1 or more). Workers spin
+// briefly after each run and then sleep until the next one.
+// Returns NULL on failure.
+SamplecrateWorkerPool* samplecrate_worker_pool_create(int num_workers);
+
+// Stop and join all workers (no run may be in progress)
+void samplecrate_worker_pool_destroy(SamplecrateWorkerPool* pool);
+
+// Number of helper threads (0 for a NULL pool)
+int samplecrate_worker_pool_get_workers(SamplecrateWorkerPool* pool);
+
+// Run task(ctx, 0 .. count-1) across the workers and the calling thread, and
+// return when every task has finished (fork/join). Lock-free and allocation
+// free, so it can be called from the audio thread. A NULL pool runs the
+// tasks serially on the caller. Only one thread may run at a time.
+void samplecrate_worker_pool_run(SamplecrateWorkerPool* pool, SamplecrateWorkerTask task, void* ctx, int count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SAMPLECRATE_WORKER_POOL_H
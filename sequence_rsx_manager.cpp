@@ -139,6 +139,7 @@ int sequence_rsx_remove(SamplecrateRSX* rsx, uint8_t slot, const char* rsx_path)
     last_seq->enabled = 1;
     last_seq->loop = 1;
     last_seq->program_number = 0;
+    last_seq->midi_output_channel = -1;
 
     // Save RSX file to persist changes
     if (rsx_path && rsx_path[0] != '\0') {
@@ -0,0 +1,113 @@
+// Ordering of timed MIDI output: messages queued out of time order within
+// one audio block must leave the output thread in timestamp order.
+#include "midi_output_heap.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        printf("[TEST] FAIL %s:%d: ", __FILE__, __LINE__); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+        failures++; \
+    } \
+} while (0)
+
+static MidiOutputHeap heap;
+
+// One 5.8 ms block (256 frames at 44.1 kHz): the sequencer callback queues
+// the block's routed notes first, then midi_clock_output_block queues the
+// clock messages that fall inside the block
+static void test_notes_and_clock_in_one_block(void) {
+    const uint64_t block_us = 1000000;
+    midi_output_heap_reset(&heap);
+
+    // Routed notes (channel 1) at their frame offsets
+    const unsigned char note_on[3] = { 0x90, 36, 100 };
+    const unsigned char note_off[3] = { 0x80, 36, 0 };
+    const unsigned char hat_on[3] = { 0x90, 42, 90 };
+    CHECK(midi_output_heap_push(&heap, block_us + 4800, note_on, 3) == 0, "push note");
+    CHECK(midi_output_heap_push(&heap, block_us + 300, note_off, 3) == 0, "push note");
+    CHECK(midi_output_heap_push(&heap, block_us + 2500, hat_on, 3) == 0, "push note");
+
+    // Start and clock pulses of the same block
+    const unsigned char start[1] = { 0xFA };
+    const unsigned char clock[1] = { 0xF8 };
+    CHECK(midi_output_heap_push(&heap, block_us, start, 1) == 0, "push start");
+    CHECK(midi_output_heap_push(&heap, block_us, clock, 1) == 0, "push clock");
+    CHECK(midi_output_heap_push(&heap, block_us + 2500, clock, 1) == 0, "push clock");
+
+    // Expected: by time, then queue order for equal times
+    const unsigned char expected_status[] = { 0xFA, 0xF8, 0x80, 0x90, 0xF8, 0x90 };
+    const uint64_t expected_time[] = { 0, 0, 300, 2500, 2500, 4800 };
+    for (int i = 0; i < 6; i++) {
+        const MidiOutputMessage* msg = midi_output_heap_peek(&heap);
+        CHECK(msg != NULL, "message %d missing", i);
+        if (!msg) return;
+        CHECK(msg->data[0] == expected_status[i] && msg->timestamp_us == block_us + expected_time[i],
+              "message %d: got 0x%02X at +%llu, want 0x%02X at +%llu", i, msg->data[0],
+              (unsigned long long)(msg->timestamp_us - block_us), expected_status[i],
+              (unsigned long long)expected_time[i]);
+        midi_output_heap_pop(&heap);
+    }
+    CHECK(midi_output_heap_peek(&heap) == NULL, "heap not empty");
+}
+
+// Many blocks of random notes and clock pulses, popped as they come due
+static void test_random_blocks(void) {
+    midi_output_heap_reset(&heap);
+    srand(1234);
+
+    uint64_t last_sent = 0;
+    uint32_t last_order = 0;
+    int sent = 0;
+    for (int block = 0; block < 2000; block++) {
+        uint64_t block_us = 1000000 + (uint64_t)block * 5805;
+
+        for (int n = rand() % 8; n > 0; n--) {
+            unsigned char msg[3] = { 0x90, (unsigned char)(rand() % 128), 100 };
+            midi_output_heap_push(&heap, block_us + (uint64_t)(rand() % 5805), msg, 3);
+        }
+        if (rand() % 4 == 0) {
+            unsigned char msg[1] = { 0xF8 };
+            midi_output_heap_push(&heap, block_us + (uint64_t)(rand() % 5805), msg, 1);
+        }
+
+        // Send everything due before the next block starts
+        const MidiOutputMessage* msg;
+        while ((msg = midi_output_heap_peek(&heap)) && msg->timestamp_us < block_us + 5805) {
+            CHECK(msg->timestamp_us > last_sent || (msg->timestamp_us == last_sent && msg->order > last_order) ||
+                  sent == 0, "out of order at block %d", block);
+            last_sent = msg->timestamp_us;
+            last_order = msg->order;
+            midi_output_heap_pop(&heap);
+            sent++;
+        }
+    }
+    CHECK(sent > 0, "nothing sent");
+}
+
+static void test_full(void) {
+    midi_output_heap_reset(&heap);
+    const unsigned char clock[1] = { 0xF8 };
+    for (int i = 0; i < MIDI_OUTPUT_HEAP_SIZE; i++) {
+        CHECK(midi_output_heap_push(&heap, (uint64_t)(MIDI_OUTPUT_HEAP_SIZE - i), clock, 1) == 0, "push %d", i);
+    }
+    CHECK(midi_output_heap_push(&heap, 0, clock, 1) == -1, "push into a full heap");
+    CHECK(midi_output_heap_peek(&heap)->timestamp_us == 1, "earliest not on top");
+}
+
+int main(void) {
+    test_notes_and_clock_in_one_block();
+    test_random_blocks();
+    test_full();
+
+    if (failures > 0) {
+        printf("[TEST] midi_output_heap: %d failure(s)\n", failures);
+        return 1;
+    }
+    printf("[TEST] midi_output_heap: OK\n");
+    return 0;
+}